@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Starts, queries and stops the automode_main templates of a set of .argos instances.
+# Each template loads the plugins and its experiment once, then listens on a Unix socket
+# and evaluates every job in a child process forked from the loaded simulator.
+
+# Syntax printing
+function print_syntax() {
+    echo
+    echo "Usage: $0 start <AUTOMODE_MAIN> <SOCKET_DIR> <INSTANCE.argos>..."
+    echo "       $0 run <SOCKET_DIR> <INSTANCE.argos> <SEED> <FSM_CONFIG>..."
+    echo "       $0 stop <SOCKET_DIR>"
+    echo
+    exit 1
+}
+
+function socket_of() {
+  SOCKET_DIR=$1
+  INSTANCE=$2
+  echo "${SOCKET_DIR}/$(basename ${INSTANCE} .argos).sock"
+}
+
+function start_templates() {
+  EXE=$1
+  SOCKET_DIR=$2
+  shift 2
+  mkdir -p ${SOCKET_DIR}
+  for INSTANCE in "$@"
+  do
+    SOCKET=$(socket_of ${SOCKET_DIR} ${INSTANCE})
+    ${EXE} -n -c ${INSTANCE} --fork-server --serve-socket ${SOCKET} > ${SOCKET%.sock}.log 2>&1 &
+    echo $! >> ${SOCKET_DIR}/templates.pid
+  done
+}
+
+function run_job() {
+  SOCKET=$(socket_of $1 $2)
+  SEED=$3
+  shift 3
+  echo "${SEED} $*" | socat - UNIX-CONNECT:${SOCKET} | grep -o -E 'Score [-+0-9.e]+|Error .*'
+}
+
+function stop_templates() {
+  SOCKET_DIR=$1
+  if [ -f ${SOCKET_DIR}/templates.pid ]; then
+    kill $(cat ${SOCKET_DIR}/templates.pid) 2> /dev/null
+    rm -f ${SOCKET_DIR}/templates.pid ${SOCKET_DIR}/*.sock
+  fi
+}
+
+case "$1" in
+  start)
+    [ $# -lt 4 ] && print_syntax
+    shift
+    start_templates "$@"
+    ;;
+  run)
+    [ $# -lt 5 ] && print_syntax
+    shift
+    run_job "$@"
+    ;;
+  stop)
+    [ $# -lt 2 ] && print_syntax
+    stop_templates $2
+    ;;
+  *)
+    print_syntax
+    ;;
+esac
@@ -0,0 +1,83 @@
+/*
+ * @file <src/AutoMoDeCompileFsm.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief Compiles finite state machine configurations into a compiled file,
+ * 				which automode_main (--fsm-binary, --fsm-batch) and the controller
+ * 				(fsm-binary attribute) load without parsing.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <argos3/core/utility/logging/argos_log.h>
+
+#include "./core/AutoMoDeFsmBinary.h"
+#include "./core/AutoMoDeFsmConfig.h"
+
+using namespace argos;
+
+const std::string ExplainParameters() {
+	std::string strExplanation = "Usage: automode_compile_fsm OUTPUT (--fsm-file FILE | --fsm-config CONF)\n\n"
+		" OUTPUT \t The compiled file to write\n"
+		" --fsm-file FILE \t A file containing descriptions of finite state machines, one per line\n"
+		" --fsm-config CONF \t A description of a finite state machine, placed at the end of the command line\n"
+		"\n Empty lines and lines starting with '#' are skipped. The finite state machines keep their order in the compiled file.";
+	return strExplanation;
+}
+
+int main(int n_argc, char** ppch_argv) {
+	if (n_argc < 3 || strcmp(ppch_argv[1], "--help") == 0) {
+		std::cout << ExplainParameters() << std::endl;
+		return (n_argc < 3 ? 1 : 0);
+	}
+
+	try {
+		std::string strOutputFile(ppch_argv[1]);
+		std::vector<AutoMoDeFsmConfig> vecFsmConfigs;
+
+		if (strcmp(ppch_argv[2], "--fsm-config") == 0) {
+			std::string strFsmConfig;
+			for (int i = 3; i < n_argc; ++i) {
+				strFsmConfig += std::string(ppch_argv[i]) + " ";
+			}
+			vecFsmConfigs.push_back(AutoMoDeFsmConfig());
+			vecFsmConfigs.back().Parse(strFsmConfig);
+		} else if (strcmp(ppch_argv[2], "--fsm-file") == 0 && n_argc == 4) {
+			std::ifstream cFsmFile(ppch_argv[3]);
+			if (cFsmFile.fail()) {
+				THROW_ARGOSEXCEPTION("Error opening file \"" << ppch_argv[3] << "\"");
+			}
+			std::string strLine;
+			UInt64 unLineNumber = 0;
+			while (std::getline(cFsmFile, strLine)) {
+				++unLineNumber;
+				size_t unFirstCharacter = strLine.find_first_not_of(" \t\r");
+				if (unFirstCharacter == std::string::npos || strLine[unFirstCharacter] == '#') {
+					continue;
+				}
+				vecFsmConfigs.push_back(AutoMoDeFsmConfig());
+				try {
+					vecFsmConfigs.back().Parse(strLine);
+				} catch (CARGoSException& ex) {
+					THROW_ARGOSEXCEPTION_NESTED("Error parsing line " << unLineNumber, ex);
+				}
+			}
+		} else {
+			THROW_ARGOSEXCEPTION(ExplainParameters());
+		}
+
+		AutoMoDeFsmBinary::Write(strOutputFile, vecFsmConfigs);
+		std::cout << "Compiled " << vecFsmConfigs.size() << " finite state machines into " << strOutputFile << std::endl;
+	} catch (std::exception& ex) {
+		LOGERR << ex.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -13,39 +13,918 @@
 #include <argos3/core/simulator/entity/entity.h>
 #include <argos3/core/simulator/entity/controllable_entity.h>
 #include <argos3/core/utility/plugins/dynamic_loading.h>
+#include <argos3/core/utility/configuration/argos_configuration.h>
 #include <argos3/core/simulator/argos_command_line_arg_parser.h>
 
+#include "./core/AutoMoDeArena.h"
 #include "./core/AutoMoDeFiniteStateMachine.h"
+#include "./core/AutoMoDeFsmBinary.h"
 #include "./core/AutoMoDeFsmBuilder.h"
+#include "./core/AutoMoDeFsmTemplates.h"
+#include "./core/AutoMoDeFsmValidator.h"
 #include "./core/AutoMoDeController.h"
+#include "./core/AutoMoDeEvaluationCache.h"
+#include "./core/AutoMoDeHash.h"
+#include "./core/AutoMoDeSwarmEngine.h"
 
 #include <argos3/demiurge/loop-functions/CoreLoopFunctions.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <set>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 using namespace argos;
 
+/*
+ * Exit code of automode_main when the finite state machine configuration is invalid.
+ * The configuration is checked before the libraries and the experiment are loaded.
+ */
+static const int INVALID_FSM_EXIT_CODE = 2;
+
+/*
+ * Wall-clock time spent in each phase of a run of automode_main, in seconds.
+ * The evaluation phases are summed over all the evaluations of the run.
+ */
+struct SEvaluationProfile {
+	Real LoadLibraries;
+	Real LoadExperiment;
+	/* Extraction of the group configurations and construction of the finite state machines. */
+	Real BuildFsm;
+	Real Execute;
+	Real Destroy;
+	UInt64 Ticks;
+	UInt32 Evaluations;
+
+	SEvaluationProfile() :
+		LoadLibraries(0),
+		LoadExperiment(0),
+		BuildFsm(0),
+		Execute(0),
+		Destroy(0),
+		Ticks(0),
+		Evaluations(0) {}
+};
+
+/*
+ * Returns the time elapsed since an arbitrary point, in seconds.
+ */
+Real GetWallClock() {
+	struct timespec sTime;
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+	return sTime.tv_sec + sTime.tv_nsec * 1e-9;
+}
+
+/*
+ * Formats the profile as a single line "Profile KEY=VALUE ...", completed with the peak
+ * resident set size (in kB) and the page faults of the process.
+ */
+std::string FormatProfile(const SEvaluationProfile& s_profile) {
+	struct rusage sUsage;
+	memset(&sUsage, 0, sizeof(sUsage));
+	getrusage(RUSAGE_SELF, &sUsage);
+	std::ostringstream ossProfile;
+	ossProfile << "Profile"
+		<< " load-libraries=" << s_profile.LoadLibraries
+		<< " load-experiment=" << s_profile.LoadExperiment
+		<< " build-fsm=" << s_profile.BuildFsm
+		<< " execute=" << s_profile.Execute
+		<< " destroy=" << s_profile.Destroy
+		<< " evaluations=" << s_profile.Evaluations
+		<< " ticks=" << s_profile.Ticks
+		<< " ticks-per-second=" << (s_profile.Execute > 0 ? s_profile.Ticks / s_profile.Execute : 0)
+		<< " peak-rss-kb=" << sUsage.ru_maxrss
+		<< " minor-faults=" << sUsage.ru_minflt
+		<< " major-faults=" << sUsage.ru_majflt;
+	return ossProfile.str();
+}
+
+/*
+ * Settings shared by all the evaluations of a run of automode_main.
+ */
+struct SEvaluationSettings {
+	/* Whether the history of the finite state machines is maintained. */
+	bool History;
+	/* Whether the evaluations take place in forked child processes. */
+	bool Fork;
+	/* Whether the evaluations are stopped once they cannot beat ScoreBound. */
+	bool UseScoreBound;
+	Real ScoreBound;
+	/* Largest decrease of the score in one tick. */
+	Real ScoreBoundRate;
+	/* Number of ticks between two checks of the bound. */
+	UInt32 ScoreBoundInterval;
+	/* Cache of the results of the evaluations, or NULL. */
+	AutoMoDeEvaluationCache* Cache;
+	/* Digest of the experiment file, part of the keys of the cache. */
+	SAutoMoDeDigest Instance;
+	/* Profile the phases of the evaluations are added to, or NULL. */
+	SEvaluationProfile* Profile;
+	/* Engine stepping the finite state machines of the swarm, or NULL if the controllers step their own. */
+	AutoMoDeSwarmEngine* Engine;
+
+	SEvaluationSettings() :
+		History(false),
+		Fork(false),
+		UseScoreBound(false),
+		ScoreBound(0),
+		ScoreBoundRate(0),
+		ScoreBoundInterval(10),
+		Cache(NULL),
+		Profile(NULL),
+		Engine(NULL) {}
+};
+
+/*
+ * Outcome of an evaluation. When Capped is set, the evaluation was stopped early
+ * and Score is a lower bound of the score the swarm would have obtained.
+ */
+struct SEvaluationResult {
+	Real Score;
+	bool Capped;
+
+	SEvaluationResult() :
+		Score(0),
+		Capped(false) {}
+};
+
+/*
+ * Formats a result as printed by automode_main: "VALUE", followed by " capped" if needed.
+ */
+std::string FormatResult(const SEvaluationResult& s_result) {
+	std::ostringstream ossResult;
+	ossResult << s_result.Score;
+	if (s_result.Capped) {
+		ossResult << " capped";
+	}
+	return ossResult.str();
+}
+
 const std::string ExplainParameters() {
 	std::string strExplanation = "Missing finite state machine configuration. The possible parameters are: \n\n"
 		" -r | --readable-fsm \t Prints an URL containing a DOT representation of the finite state machine [OPTIONAL]. \n"
 		" -s | --seed \t The seed for the ARGoS simulator [OPTIONAL] \n"
-		" --fsm-config CONF \t The finite state machine description [MANDATORY]\n"
-		"\n The description of the finite state machine should be placed at the end of the command line, after the other parameters.";
+		" --seeds S1,S2,... \t Evaluates the finite state machine once per seed of the list [OPTIONAL] \n"
+		" --seeds-stats \t Also prints the mean and the variance of the scores obtained with --seeds [OPTIONAL] \n"
+		" --fsm-batch FILE \t Evaluates, one after the other, the finite state machines described on each line of FILE, or held by the compiled file FILE [OPTIONAL] \n"
+		" --batch-output FILE \t Appends the \"LINE SCORE\" records of --fsm-batch to FILE instead of printing them [OPTIONAL] \n"
+		" --fsm-binary FILE \t Evaluates a finite state machine of the compiled file FILE (see automode_compile_fsm) instead of --fsm-config [OPTIONAL] \n"
+		" --fsm-index N \t Index of the finite state machine of --fsm-binary to evaluate (default: 0) [OPTIONAL] \n"
+		" --serve \t Loads the experiment once and evaluates the jobs read on the standard input [OPTIONAL] \n"
+		" --serve-socket PATH \t Same as --serve, but the jobs are read from the Unix socket PATH [OPTIONAL] \n"
+		" --score-bound B \t Stops the evaluation as soon as its score provably cannot be lower than B [OPTIONAL] \n"
+		" --score-bound-interval N \t Number of ticks between two checks of --score-bound (default: 10) [OPTIONAL] \n"
+		" --score-bound-rate R \t Largest decrease of the score in one tick, used by --score-bound (default: 0) [OPTIONAL] \n"
+		" --fork-server \t When serving, evaluates each job in a child process forked from the loaded experiment [OPTIONAL] \n"
+		" --cache FILE \t Reuses the results stored in FILE, and stores the new ones in it. FILE can be shared by concurrent runs [OPTIONAL] \n"
+		" --cache-size N \t Number of results FILE can hold when --cache creates it (default: 1048576) [OPTIONAL] \n"
+		" --cache-stats \t Prints the statistics of --cache on the standard error at the end of the run [OPTIONAL] \n"
+		" --selective-loading \t Only loads the libraries the experiment refers to, instead of all the ARGoS plugins [OPTIONAL] \n"
+		" --profile \t Prints a \"Profile\" line with the time spent in each phase and the resources used [OPTIONAL] \n"
+		" --swarm-engine \t Steps the finite state machines of all the robots together, group by group, instead of in each controller [OPTIONAL] \n"
+		" --fsm-config CONF \t The finite state machine description [MANDATORY unless serving or batch]\n"
+		"\n The description of the finite state machine should be placed at the end of the command line, after the other parameters."
+		"\n With a compiled --fsm-batch file, LINE is the position of the finite state machine in the file, starting from 1."
+		"\n In serving mode, each job is a line \"SEED CONF\" and is answered by a line \"Score VALUE\" (or \"Error MESSAGE\")."
+		"\n An evaluation stopped by --score-bound is reported as \"Score VALUE capped\", VALUE being a lower bound of its final score."
+		"\n With --serve or --fsm-batch, the \"Profile\" line sums up all the jobs and is printed on the standard error."
+		"\n An invalid finite state machine configuration is reported before the experiment is loaded, with the exit code 2.";
 	return strExplanation;
 }
 
+/*
+ * Plugin library (libargos3plugin_simulator_<NAME>) providing each element of the experiment
+ * file the plugins are needed for: entities, physics engines, media and visualizations.
+ */
+static const char* PLUGIN_LIBRARIES[][2] = {
+	{"e-puck", "epuck"},
+	{"foot-bot", "footbot"},
+	{"eye-bot", "eyebot"},
+	{"kheperaiv", "kheperaiv"},
+	{"spiri", "spiri"},
+	{"box", "entities"},
+	{"cylinder", "entities"},
+	{"light", "entities"},
+	{"dynamics2d", "dynamics2d"},
+	{"dynamics3d", "dynamics3d"},
+	{"pointmass3d", "pointmass3d"},
+	{"led", "media"},
+	{"directional_led", "media"},
+	{"range_and_bearing", "media"},
+	{"tag", "media"},
+	{"radio", "media"},
+	{"qt-opengl", "qtopengl"}
+};
+
+/*
+ * Adds to set_libraries the plugin library of the element t_node. The floor is part of the
+ * core, and the elements distributed by a <distribute> node are looked for in its <entity> nodes.
+ * Returns false if the plugin of the element is unknown.
+ */
+bool CollectPluginLibrary(TConfigurationNode& t_node, std::set<std::string>& set_libraries) {
+	std::string strTag = t_node.Value();
+	if (strTag == "floor") {
+		return true;
+	}
+	if (strTag == "distribute" || strTag == "entity") {
+		TConfigurationNodeIterator itChild("*");
+		for (itChild = itChild.begin(&t_node); itChild != itChild.end(); ++itChild) {
+			if ((strTag == "distribute" && itChild->Value() == "entity") || strTag == "entity") {
+				if (!CollectPluginLibrary(*itChild, set_libraries)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	for (UInt32 i = 0; i < sizeof(PLUGIN_LIBRARIES) / sizeof(PLUGIN_LIBRARIES[0]); ++i) {
+		if (strTag == PLUGIN_LIBRARIES[i][0]) {
+			set_libraries.insert(std::string("libargos3plugin_simulator_") + PLUGIN_LIBRARIES[i][1]);
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Loads the libraries the experiment file refers to, rather than all the libraries of the
+ * plugin path: the libraries of the controllers and of the loop functions, and the plugins
+ * of the elements of the arena, physics engines, media and visualization. The libraries
+ * these ones depend on are loaded along with them.
+ * If the libraries cannot be determined or loaded, all the libraries are loaded instead.
+ * Returns whether the selective loading succeeded.
+ */
+bool LoadReferencedLibraries(const std::string& str_experiment_file) {
+	std::set<std::string> setPlugins;
+	std::vector<std::string> vecLibraries;
+	bool bComplete = true;
+	try {
+		ticpp::Document cDocument(str_experiment_file);
+		cDocument.LoadFile();
+		TConfigurationNode& tRoot = *cDocument.FirstChildElement();
+		TConfigurationNodeIterator itSection("*");
+		for (itSection = itSection.begin(&tRoot); itSection != itSection.end() && bComplete; ++itSection) {
+			std::string strSection = itSection->Value();
+			std::string strLibrary;
+			if (strSection == "loop_functions") {
+				GetNodeAttributeOrDefault(*itSection, "library", strLibrary, strLibrary);
+				if (!strLibrary.empty()) {
+					vecLibraries.push_back(strLibrary);
+				}
+			} else if (strSection == "controllers" || strSection == "arena" || strSection == "physics_engines"
+				|| strSection == "media" || strSection == "visualization") {
+				TConfigurationNodeIterator itNode("*");
+				for (itNode = itNode.begin(&(*itSection)); itNode != itNode.end() && bComplete; ++itNode) {
+					if (strSection == "controllers") {
+						strLibrary.clear();
+						GetNodeAttributeOrDefault(*itNode, "library", strLibrary, strLibrary);
+						if (!strLibrary.empty()) {
+							vecLibraries.push_back(strLibrary);
+						}
+					} else {
+						bComplete = CollectPluginLibrary(*itNode, setPlugins);
+					}
+				}
+			}
+		}
+		if (bComplete) {
+			// The robots need the generic sensors and actuators.
+			setPlugins.insert("libargos3plugin_simulator_genericrobot");
+			setPlugins.insert("libargos3plugin_simulator_entities");
+			for (std::set<std::string>::iterator it = setPlugins.begin(); it != setPlugins.end(); ++it) {
+				CDynamicLoading::LoadLibrary(*it);
+			}
+			for (UInt32 i = 0; i < vecLibraries.size(); ++i) {
+				CDynamicLoading::LoadLibrary(vecLibraries.at(i));
+			}
+		}
+	} catch (std::exception& ex) {
+		LOGERR << "[WARNING] Selective loading failed: " << ex.what() << std::endl;
+		bComplete = false;
+	}
+	if (!bComplete) {
+		CDynamicLoading::LoadAllLibraries();
+	}
+	return bComplete;
+}
+
+/*
+ * The finite state machines handed to the robots. Those of an evaluation are placed, with
+ * their modules, in one arena and released together. The two arenas are used in turn, so
+ * that the finite state machines in use are only released once the robots received new ones.
+ */
+struct SSwarmFsm {
+	AutoMoDeArena Arenas[2];
+	UInt32 CurrentArena;
+	std::vector<AutoMoDeFiniteStateMachine*> Fsm;
+
+	SSwarmFsm() :
+		CurrentArena(0) {}
+};
+
+/*
+ * Destroys finite state machines placed in an arena, then releases the arena.
+ */
+void ReleaseFiniteStateMachines(std::vector<AutoMoDeFiniteStateMachine*>& vec_fsm, AutoMoDeArena& c_arena) {
+	for (UInt32 i = 0; i < vec_fsm.size(); ++i) {
+		vec_fsm.at(i)->~AutoMoDeFiniteStateMachine();
+	}
+	vec_fsm.clear();
+	c_arena.Clear();
+}
+
+/*
+ * A robot of the swarm, and its group.
+ */
+typedef std::pair<UInt32, AutoMoDeController*> TSwarmRobot;
+
+bool CompareRobotGroups(const TSwarmRobot& s_first, const TSwarmRobot& s_second) {
+	return s_first.first < s_second.first;
+}
+
+/*
+ * Hands to every robot of the swarm a copy of the finite state machine of its group,
+ * taken from c_templates. The copies are created group by group, so that those of a group
+ * lie together in the arena, and are handed to the swarm engine, if any. The finite state
+ * machines previously handed to the robots are released once all robots received their new one.
+ */
+void SetUpSwarm(CSimulator& c_simulator, AutoMoDeFsmTemplates& c_templates, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	std::vector<AutoMoDeFiniteStateMachine*> vecNewFsm;
+	std::vector<TSwarmRobot> vecRobots;
+	AutoMoDeArena& cNewArena = s_swarm.Arenas[1 - s_swarm.CurrentArena];
+	Real fStart = GetWallClock();
+
+	CSpace::TMapPerType cEntities = c_simulator.GetSpace().GetEntitiesByType("controller");
+	try {
+		for (CSpace::TMapPerType::iterator it = cEntities.begin(); it != cEntities.end(); ++it) {
+			CControllableEntity* pcEntity = any_cast<CControllableEntity*>(it->second);
+			AutoMoDeController& cController = dynamic_cast<AutoMoDeController&> (pcEntity->GetController());
+			vecRobots.push_back(TSwarmRobot(c_templates.GetGroupOfRobot(cController.GetRobotNumericId()), &cController));
+		}
+		std::stable_sort(vecRobots.begin(), vecRobots.end(), CompareRobotGroups);
+		for (UInt32 i = 0; i < vecRobots.size(); ++i) {
+			vecNewFsm.push_back(c_templates.CreateFiniteStateMachine(vecRobots.at(i).second->GetRobotNumericId(), cNewArena));
+		}
+	} catch (std::exception& ex) {
+		ReleaseFiniteStateMachines(vecNewFsm, cNewArena);
+		throw;
+	}
+
+	if (s_settings.Engine != NULL) {
+		s_settings.Engine->Clear();
+	}
+	for (UInt32 i = 0; i < vecRobots.size(); ++i) {
+		AutoMoDeController* pcController = vecRobots.at(i).second;
+		pcController->SetFiniteStateMachine(vecNewFsm.at(i));
+		pcController->SetHistoryFlag(s_settings.History);
+		if (s_settings.Engine != NULL) {
+			s_settings.Engine->AddRobot(pcController, vecRobots.at(i).first);
+		}
+	}
+
+	ReleaseFiniteStateMachines(s_swarm.Fsm, s_swarm.Arenas[s_swarm.CurrentArena]);
+	s_swarm.Fsm = vecNewFsm;
+	s_swarm.CurrentArena = 1 - s_swarm.CurrentArena;
+
+	if (s_settings.Profile != NULL) {
+		s_settings.Profile->BuildFsm += GetWallClock() - fStart;
+	}
+}
+
+/*
+ * Runs the loaded experiment until its end and returns the score of the swarm.
+ * With a score bound, the simulation is stepped here rather than by the visualization,
+ * and the objective function is polled every ScoreBoundInterval ticks. As the score can
+ * decrease by at most ScoreBoundRate per tick, the final score cannot be lower than
+ * (current score - ScoreBoundRate * remaining ticks): once this exceeds the bound, the
+ * evaluation is hopeless and is stopped.
+ * The loop functions must therefore update their objective function during the run.
+ */
+SEvaluationResult RunExperiment(CSimulator& c_simulator, const SEvaluationSettings& s_settings) {
+	SEvaluationResult sResult;
+	// A swarm engine stands in for the loop functions of the experiment.
+	CLoopFunctions& cExperimentLoopFunctions = (s_settings.Engine != NULL) ? s_settings.Engine->GetLoopFunctions() : c_simulator.GetLoopFunctions();
+	CoreLoopFunctions& cLoopFunctions = dynamic_cast<CoreLoopFunctions&> (cExperimentLoopFunctions);
+	Real fStart = GetWallClock();
+
+	if (!s_settings.UseScoreBound) {
+		c_simulator.Execute();
+	} else {
+		UInt32 unMaxClock = c_simulator.GetMaxSimulationClock();
+		UInt32 unInterval = Max<UInt32>(1, s_settings.ScoreBoundInterval);
+		// Without a length, the experiment only has a lower bound if the score never decreases.
+		bool bBounded = (unMaxClock > 0 || s_settings.ScoreBoundRate <= 0);
+		while (!c_simulator.IsExperimentFinished()) {
+			c_simulator.UpdateSpace();
+			UInt32 unClock = c_simulator.GetSpace().GetSimulationClock();
+			if (bBounded && unClock % unInterval == 0) {
+				Real fLowerBound = cLoopFunctions.GetObjectiveFunction();
+				if (s_settings.ScoreBoundRate > 0) {
+					fLowerBound -= s_settings.ScoreBoundRate * (unMaxClock - Min<UInt32>(unClock, unMaxClock));
+				}
+				if (fLowerBound > s_settings.ScoreBound) {
+					sResult.Score = fLowerBound;
+					sResult.Capped = true;
+					break;
+				}
+			}
+		}
+		if (!sResult.Capped) {
+			cLoopFunctions.PostExperiment();
+		}
+	}
+
+	if (s_settings.Profile != NULL) {
+		s_settings.Profile->Execute += GetWallClock() - fStart;
+		s_settings.Profile->Ticks += c_simulator.GetSpace().GetSimulationClock();
+		s_settings.Profile->Evaluations++;
+	}
+
+	// Retrieval of the score of the swarm driven by the Finite State Machine
+	if (!sResult.Capped) {
+		sResult.Score = cLoopFunctions.GetObjectiveFunction();
+	}
+	return sResult;
+}
+
+/*
+ * Resets the simulator with the given seed, hands the finite state machines of
+ * c_templates to the robots and runs the experiment. Returns the score of the swarm.
+ */
+SEvaluationResult EvaluateConfiguration(CSimulator& c_simulator, UInt32 un_seed, AutoMoDeFsmTemplates& c_templates, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	c_simulator.SetRandomSeed(un_seed);
+	c_simulator.Reset();
+	SetUpSwarm(c_simulator, c_templates, s_settings, s_swarm);
+	return RunExperiment(c_simulator, s_settings);
+}
+
+/*
+ * Same as EvaluateConfiguration, but the evaluation takes place in a child process
+ * forked from the current one. The child shares the loaded simulator copy-on-write and
+ * sends its result back through a pipe, so that the state of the current process is left
+ * untouched and a crashing configuration cannot affect the next evaluations.
+ * The whole life of the child is profiled as the execution of the evaluation.
+ */
+SEvaluationResult EvaluateConfigurationInChild(CSimulator& c_simulator, UInt32 un_seed, AutoMoDeFsmTemplates& c_templates, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	int pnPipe[2];
+	if (pipe(pnPipe) != 0) {
+		THROW_ARGOSEXCEPTION("Could not create the pipe to the evaluation process");
+	}
+	// Pending output would otherwise be written by both processes.
+	fflush(NULL);
+	Real fStart = GetWallClock();
+	pid_t nPid = fork();
+	if (nPid < 0) {
+		close(pnPipe[0]);
+		close(pnPipe[1]);
+		THROW_ARGOSEXCEPTION("Could not fork the evaluation process");
+	}
+
+	if (nPid == 0) {
+		close(pnPipe[0]);
+		std::ostringstream ossResult;
+		try {
+			SEvaluationResult sResult = EvaluateConfiguration(c_simulator, un_seed, c_templates, s_settings, s_swarm);
+			ossResult.precision(17);
+			ossResult << (sResult.Capped ? "Capped " : "Score ") << sResult.Score << " " << c_simulator.GetSpace().GetSimulationClock();
+		} catch (std::exception& ex) {
+			ossResult.str("");
+			ossResult << "Error " << ex.what();
+		}
+		std::string strResult = ossResult.str();
+		size_t unWritten = 0;
+		while (unWritten < strResult.size()) {
+			ssize_t nBytes = write(pnPipe[1], strResult.c_str() + unWritten, strResult.size() - unWritten);
+			if (nBytes <= 0) {
+				break;
+			}
+			unWritten += nBytes;
+		}
+		close(pnPipe[1]);
+		// Leave without destroying the copy of the simulator.
+		_exit(0);
+	}
+
+	close(pnPipe[1]);
+	std::string strResult;
+	char pchBuffer[512];
+	ssize_t nBytes;
+	while ((nBytes = read(pnPipe[0], pchBuffer, sizeof(pchBuffer))) != 0) {
+		if (nBytes < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		strResult.append(pchBuffer, nBytes);
+	}
+	close(pnPipe[0]);
+
+	int nStatus = 0;
+	while (waitpid(nPid, &nStatus, 0) < 0 && errno == EINTR) {}
+
+	if (strResult.compare(0, 6, "Score ") == 0 || strResult.compare(0, 7, "Capped ") == 0) {
+		SEvaluationResult sResult;
+		sResult.Capped = (strResult[0] == 'C');
+		char* pchTicks = NULL;
+		sResult.Score = strtod(strResult.c_str() + (sResult.Capped ? 7 : 6), &pchTicks);
+		if (s_settings.Profile != NULL) {
+			s_settings.Profile->Execute += GetWallClock() - fStart;
+			s_settings.Profile->Ticks += strtoull(pchTicks, NULL, 10);
+			s_settings.Profile->Evaluations++;
+		}
+		return sResult;
+	} else if (strResult.compare(0, 6, "Error ") == 0) {
+		THROW_ARGOSEXCEPTION(strResult.substr(6));
+	} else if (WIFSIGNALED(nStatus)) {
+		THROW_ARGOSEXCEPTION("The evaluation process was killed by signal " << WTERMSIG(nStatus));
+	}
+	THROW_ARGOSEXCEPTION("The evaluation process ended without result");
+}
+
+/*
+ * Version of the behaviour of the robots, part of the keys of the cache. It must be increased
+ * whenever the same configuration and seed give different trajectories, so that the results
+ * stored by the previous versions are not reused.
+ *   2: the transitions are shuffled with the generator of the robot instead of rand().
+ *   3: the random draws of the finite state machine come from the Philox stream of the robot.
+ */
+static const UInt64 BEHAVIOUR_VERSION = 3;
+
+/*
+ * Computes the key identifying the evaluation of the finite state machines of c_templates
+ * with the seed un_seed on the loaded experiment. The key is built from the structural hashes
+ * of the finite state machines the robots would be given, in the order of the robots, rather
+ * than from the text of the configuration: equivalent configurations share their key.
+ */
+SAutoMoDeDigest ComputeEvaluationKey(CSimulator& c_simulator, UInt32 un_seed, AutoMoDeFsmTemplates& c_templates, const SEvaluationSettings& s_settings) {
+	AutoMoDeHash cHash;
+	cHash.Update(BEHAVIOUR_VERSION);
+	cHash.Update(s_settings.Instance);
+	cHash.Update((UInt64) un_seed);
+
+	CSpace::TMapPerType& cEntities = c_simulator.GetSpace().GetEntitiesByType("controller");
+	for (CSpace::TMapPerType::iterator it = cEntities.begin(); it != cEntities.end(); ++it) {
+		CControllableEntity* pcEntity = any_cast<CControllableEntity*>(it->second);
+		AutoMoDeController& cController = dynamic_cast<AutoMoDeController&> (pcEntity->GetController());
+		cHash.Update(c_templates.GetStructuralHash(c_templates.GetGroupOfRobot(cController.GetRobotNumericId())));
+	}
+	return cHash.GetDigest();
+}
+
+/*
+ * Looks the result of an evaluation up in the cache. A capped result only answers the
+ * evaluation if it also exceeds the current score bound.
+ */
+bool LookupResult(const SAutoMoDeDigest& s_key, const SEvaluationSettings& s_settings, SEvaluationResult& s_result) {
+	if (s_settings.Cache == NULL || !s_settings.Cache->Lookup(s_key, s_result.Score, s_result.Capped)) {
+		return false;
+	}
+	return !s_result.Capped || (s_settings.UseScoreBound && s_result.Score > s_settings.ScoreBound);
+}
+
+/*
+ * Throws if c_fsm_config is not valid, listing all its problems.
+ * @see AutoMoDeFsmValidator
+ */
+void ValidateFsmConfig(const AutoMoDeFsmConfig& c_fsm_config) {
+	AutoMoDeFsmValidator cValidator;
+	if (!cValidator.Validate(c_fsm_config)) {
+		THROW_ARGOSEXCEPTION("Invalid finite state machine configuration: " << cValidator.GetReport());
+	}
+}
+
+/*
+ * Evaluates str_fsm_config with the seed un_seed, unless the result is found in the cache.
+ * New results are stored in the cache.
+ */
+SEvaluationResult EvaluateJob(CSimulator& c_simulator, UInt32 un_seed, const std::string& str_fsm_config, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	SEvaluationResult sResult;
+	SAutoMoDeDigest sKey;
+	AutoMoDeFsmConfig cFsmConfig;
+	cFsmConfig.Parse(str_fsm_config);
+	ValidateFsmConfig(cFsmConfig);
+	AutoMoDeFsmTemplates cTemplates(cFsmConfig);
+	if (s_settings.Cache != NULL) {
+		sKey = ComputeEvaluationKey(c_simulator, un_seed, cTemplates, s_settings);
+		if (LookupResult(sKey, s_settings, sResult)) {
+			return sResult;
+		}
+	}
+	if (s_settings.Fork) {
+		sResult = EvaluateConfigurationInChild(c_simulator, un_seed, cTemplates, s_settings, s_swarm);
+	} else {
+		sResult = EvaluateConfiguration(c_simulator, un_seed, cTemplates, s_settings, s_swarm);
+	}
+	if (s_settings.Cache != NULL) {
+		s_settings.Cache->Insert(sKey, sResult.Score, sResult.Capped);
+	}
+	return sResult;
+}
+
+/*
+ * Parses a comma-separated list of seeds.
+ */
+std::vector<UInt32> ParseSeedList(const std::string& str_seeds) {
+	std::vector<UInt32> vecSeeds;
+	std::istringstream issSeeds(str_seeds);
+	std::string strSeed;
+	while (std::getline(issSeeds, strSeed, ',')) {
+		if (strSeed.empty()) {
+			continue;
+		}
+		try {
+			vecSeeds.push_back(std::stoul(strSeed));
+		} catch (std::exception& ex) {
+			THROW_ARGOSEXCEPTION("Invalid seed \"" << strSeed << "\" in --seeds");
+		}
+	}
+	if (vecSeeds.empty()) {
+		THROW_ARGOSEXCEPTION("Empty list of seeds given to --seeds");
+	}
+	return vecSeeds;
+}
+
+/*
+ * Evaluates the swarm, set up once, on each seed of the list. Between two seeds, the
+ * simulator is reset, which also resets the controllers and their finite state machines.
+ * Prints one score line per seed, followed by the mean and the (sample) variance if required.
+ * The seeds whose result is in the cache are not simulated.
+ */
+void RunSeeds(CSimulator& c_simulator, AutoMoDeFsmTemplates& c_templates, const std::vector<UInt32>& vec_seeds, bool b_statistics, const SEvaluationSettings& s_settings) {
+	std::vector<Real> vecScores;
+	for (UInt32 i = 0; i < vec_seeds.size(); ++i) {
+		SEvaluationResult sResult;
+		SAutoMoDeDigest sKey;
+		if (s_settings.Cache != NULL) {
+			sKey = ComputeEvaluationKey(c_simulator, vec_seeds.at(i), c_templates, s_settings);
+		}
+		if (!LookupResult(sKey, s_settings, sResult)) {
+			if (i > 0) {
+				c_simulator.SetRandomSeed(vec_seeds.at(i));
+				c_simulator.Reset();
+			}
+			sResult = RunExperiment(c_simulator, s_settings);
+			if (s_settings.Cache != NULL) {
+				s_settings.Cache->Insert(sKey, sResult.Score, sResult.Capped);
+			}
+		}
+		vecScores.push_back(sResult.Score);
+		std::cout << "Seed " << vec_seeds.at(i) << " Score " << FormatResult(sResult) << std::endl;
+	}
+
+	if (b_statistics) {
+		Real fMean = 0;
+		for (UInt32 i = 0; i < vecScores.size(); ++i) {
+			fMean += vecScores.at(i);
+		}
+		fMean /= vecScores.size();
+		Real fVariance = 0;
+		for (UInt32 i = 0; i < vecScores.size(); ++i) {
+			fVariance += (vecScores.at(i) - fMean) * (vecScores.at(i) - fMean);
+		}
+		if (vecScores.size() > 1) {
+			fVariance /= (vecScores.size() - 1);
+		}
+		std::cout << "Mean " << fMean << std::endl;
+		std::cout << "Variance " << fVariance << std::endl;
+	}
+}
+
+/*
+ * Evaluates the jobs read from pt_input on the already loaded experiment, until the
+ * end of the stream or until a "quit" line is received. A job is a line "SEED CONF":
+ * the simulator is reset with SEED and the robots are given the finite state machines
+ * described by CONF. The score of each job is written on pt_output. If the settings
+ * require it, each job is evaluated in a child process (see EvaluateConfigurationInChild).
+ * Returns false if the serving loop was ended by a "quit" line.
+ */
+bool ServeJobs(FILE* pt_input, FILE* pt_output, CSimulator& c_simulator, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	char* pchLine = NULL;
+	size_t unLineCapacity = 0;
+	bool bContinue = true;
+
+	while (getline(&pchLine, &unLineCapacity, pt_input) != -1) {
+		std::istringstream issJob(pchLine);
+		std::string strFirstToken;
+		if (!(issJob >> strFirstToken)) {
+			continue;
+		}
+		if (strFirstToken == "quit") {
+			bContinue = false;
+			break;
+		}
+		try {
+			UInt32 unSeed = std::stoul(strFirstToken);
+			std::string strFsmConfig;
+			std::getline(issJob, strFsmConfig);
+
+			SEvaluationResult sResult = EvaluateJob(c_simulator, unSeed, strFsmConfig, s_settings, s_swarm);
+			fprintf(pt_output, "Score %s\n", FormatResult(sResult).c_str());
+		} catch (std::exception& ex) {
+			std::string strMessage(ex.what());
+			std::replace(strMessage.begin(), strMessage.end(), '\n', ' ');
+			fprintf(pt_output, "Error %s\n", strMessage.c_str());
+		}
+		fflush(pt_output);
+	}
+
+	free(pchLine);
+	return bContinue;
+}
+
+/*
+ * Evaluates an entry of a batch. With a cache, an entry that already appeared in the batch
+ * is not evaluated again, even if its result could not be stored in the cache file.
+ */
+SEvaluationResult EvaluateBatchEntry(CSimulator& c_simulator, UInt32 un_seed, AutoMoDeFsmTemplates& c_templates, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm, std::map<SAutoMoDeDigest, SEvaluationResult>& map_batch_results) {
+	SEvaluationResult sResult;
+	if (s_settings.Cache == NULL) {
+		return EvaluateConfiguration(c_simulator, un_seed, c_templates, s_settings, s_swarm);
+	}
+	SAutoMoDeDigest sKey = ComputeEvaluationKey(c_simulator, un_seed, c_templates, s_settings);
+	std::map<SAutoMoDeDigest, SEvaluationResult>::iterator itResult = map_batch_results.find(sKey);
+	if (itResult != map_batch_results.end()) {
+		s_settings.Cache->CountHit();
+		return itResult->second;
+	}
+	if (!LookupResult(sKey, s_settings, sResult)) {
+		sResult = EvaluateConfiguration(c_simulator, un_seed, c_templates, s_settings, s_swarm);
+		s_settings.Cache->Insert(sKey, sResult.Score, sResult.Capped);
+	}
+	map_batch_results[sKey] = sResult;
+	return sResult;
+}
+
+/*
+ * Writes the record of an entry of a batch on pt_output.
+ */
+void WriteBatchRecord(FILE* pt_output, UInt64 un_entry, const SEvaluationResult* ps_result, const std::string& str_error) {
+	if (ps_result != NULL) {
+		fprintf(pt_output, "%llu %s\n", (unsigned long long) un_entry, FormatResult(*ps_result).c_str());
+	} else {
+		std::string strMessage(str_error);
+		std::replace(strMessage.begin(), strMessage.end(), '\n', ' ');
+		fprintf(pt_output, "%llu Error %s\n", (unsigned long long) un_entry, strMessage.c_str());
+	}
+	fflush(pt_output);
+}
+
+/*
+ * Evaluates, in turn and with the same seed, each finite state machine configuration
+ * of the file str_batch_file. The file is streamed line by line, so that it never has
+ * to fit in memory. Empty lines and lines starting with '#' are skipped. For each
+ * configuration, a record "LINE SCORE" (or "LINE Error MESSAGE") is written on pt_output.
+ * The file can also be a compiled file (see AutoMoDeFsmBinary), which is mapped in memory;
+ * the records are then numbered by the position of the configurations in the file.
+ */
+void RunBatch(const std::string& str_batch_file, FILE* pt_output, CSimulator& c_simulator, UInt32 un_seed, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	std::map<SAutoMoDeDigest, SEvaluationResult> mapBatchResults;
+
+	if (AutoMoDeFsmBinary::IsFsmBinary(str_batch_file)) {
+		AutoMoDeFsmBinary cFsmBinary(str_batch_file);
+		for (UInt32 i = 0; i < cFsmBinary.GetNumberConfigurations(); ++i) {
+			try {
+				AutoMoDeFsmConfig cFsmConfig;
+				cFsmBinary.Load(i, cFsmConfig);
+				ValidateFsmConfig(cFsmConfig);
+				AutoMoDeFsmTemplates cTemplates(cFsmConfig);
+				SEvaluationResult sResult = EvaluateBatchEntry(c_simulator, un_seed, cTemplates, s_settings, s_swarm, mapBatchResults);
+				WriteBatchRecord(pt_output, i + 1, &sResult, "");
+			} catch (std::exception& ex) {
+				WriteBatchRecord(pt_output, i + 1, NULL, ex.what());
+			}
+		}
+		return;
+	}
+
+	std::ifstream cBatchFile(str_batch_file.c_str());
+	if (cBatchFile.fail()) {
+		THROW_ARGOSEXCEPTION("Error opening file \"" << str_batch_file << "\"");
+	}
+	std::string strLine;
+	UInt64 unLineNumber = 0;
+	while (std::getline(cBatchFile, strLine)) {
+		++unLineNumber;
+		size_t unFirstCharacter = strLine.find_first_not_of(" \t\r");
+		if (unFirstCharacter == std::string::npos || strLine[unFirstCharacter] == '#') {
+			continue;
+		}
+		try {
+			AutoMoDeFsmConfig cFsmConfig;
+			cFsmConfig.Parse(strLine);
+			ValidateFsmConfig(cFsmConfig);
+			AutoMoDeFsmTemplates cTemplates(cFsmConfig);
+			SEvaluationResult sResult = EvaluateBatchEntry(c_simulator, un_seed, cTemplates, s_settings, s_swarm, mapBatchResults);
+			WriteBatchRecord(pt_output, unLineNumber, &sResult, "");
+		} catch (std::exception& ex) {
+			WriteBatchRecord(pt_output, unLineNumber, NULL, ex.what());
+		}
+	}
+}
+
+/*
+ * Listens on the Unix socket str_path and serves the jobs of the successive
+ * connections, until a connection sends a "quit" line.
+ * If the settings require forking, the process acts as a template: each connection is served by a
+ * forked copy of it, so that several clients are served in parallel, and each job is
+ * evaluated in a further child process. The template then runs until it is killed, a
+ * "quit" line only closing the connection it was sent on.
+ */
+void ServeSocket(const std::string& str_path, CSimulator& c_simulator, const SEvaluationSettings& s_settings, SSwarmFsm& s_swarm) {
+	struct sockaddr_un sAddress;
+	if (str_path.size() >= sizeof(sAddress.sun_path)) {
+		THROW_ARGOSEXCEPTION("Socket path too long: " << str_path);
+	}
+	memset(&sAddress, 0, sizeof(sAddress));
+	sAddress.sun_family = AF_UNIX;
+	strncpy(sAddress.sun_path, str_path.c_str(), sizeof(sAddress.sun_path) - 1);
+
+	int nServerSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (nServerSocket < 0) {
+		THROW_ARGOSEXCEPTION("Could not create the socket " << str_path);
+	}
+	unlink(str_path.c_str());
+	if (bind(nServerSocket, (struct sockaddr*) &sAddress, sizeof(sAddress)) < 0 || listen(nServerSocket, SOMAXCONN) < 0) {
+		close(nServerSocket);
+		THROW_ARGOSEXCEPTION("Could not listen on the socket " << str_path);
+	}
+
+	bool bContinue = true;
+	while (bContinue) {
+		int nConnection = accept(nServerSocket, NULL, NULL);
+		if (nConnection < 0) {
+			continue;
+		}
+		if (s_settings.Fork) {
+			// Collect the connection handlers that are done.
+			while (waitpid(-1, NULL, WNOHANG) > 0) {}
+			fflush(NULL);
+			pid_t nPid = fork();
+			if (nPid == 0) {
+				close(nServerSocket);
+				FILE* ptInput = fdopen(nConnection, "r");
+				FILE* ptOutput = fdopen(dup(nConnection), "w");
+				ServeJobs(ptInput, ptOutput, c_simulator, s_settings, s_swarm);
+				fclose(ptOutput);
+				fclose(ptInput);
+				_exit(0);
+			}
+			if (nPid < 0) {
+				LOGERR << "Could not fork the connection handler" << std::endl;
+			}
+			close(nConnection);
+			continue;
+		}
+		FILE* ptInput = fdopen(nConnection, "r");
+		FILE* ptOutput = fdopen(dup(nConnection), "w");
+		bContinue = ServeJobs(ptInput, ptOutput, c_simulator, s_settings, s_swarm);
+		fclose(ptOutput);
+		fclose(ptInput);
+	}
+
+	close(nServerSocket);
+	unlink(str_path.c_str());
+}
+
 /**
  * @brief
  *
  */
 int main(int n_argc, char** ppch_argv) {
 
-	bool bHistory = false;
+	SEvaluationSettings sSettings;
 
 	bool bReadableFSM = false;
+	bool bServe = false;
+	std::string strScoreBound;
+	std::string strServeSocket;
+	std::string strSeeds;
+	bool bSeedStatistics = false;
+	std::vector<UInt32> vecSeeds;
+	std::string strBatchFile;
+	std::string strBatchOutput;
+	std::string strFsmBinary;
+	UInt32 unFsmIndex = 0;
+	std::string strCacheFile;
+	UInt32 unCacheSize = 1 << 20;
+	bool bCacheStatistics = false;
+	bool bProfile = false;
+	bool bSelectiveLoading = false;
+	bool bSwarmEngine = false;
+	SEvaluationProfile sProfile;
 	std::vector<std::string> vecConfigFsm;
 	bool bFsmControllerFound = false;
 	UInt32 unSeed = 0;
 
-	std::vector<AutoMoDeFiniteStateMachine*> vecFsm;
+	SSwarmFsm sSwarm;
 
 	try {
 		// Cutting off the FSM configuration from the command line
@@ -64,10 +943,7 @@ int main(int n_argc, char** ppch_argv) {
 			}
 			nCurrentArgument++;
 		}
-		if (!bFsmControllerFound) {
-			THROW_ARGOSEXCEPTION(ExplainParameters());
-		}
-		
+
 		std::ostringstream oss;
 		for (const auto& s : vecConfigFsm) {
 			oss << s << " ";
@@ -77,24 +953,100 @@ int main(int n_argc, char** ppch_argv) {
 		CARGoSCommandLineArgParser cACLAP;
 		cACLAP.AddFlag('r', "readable-fsm", "", bReadableFSM);
 
-		cACLAP.AddFlag('t', "history", "", bHistory);
+		cACLAP.AddFlag('t', "history", "", sSettings.History);
 
 		cACLAP.AddArgument<UInt32>('s', "seed", "", unSeed);
 
+		cACLAP.AddFlag('d', "serve", "", bServe);
+
+		cACLAP.AddArgument<std::string>('u', "serve-socket", "", strServeSocket);
+
+		cACLAP.AddFlag('f', "fork-server", "", sSettings.Fork);
+
+		cACLAP.AddArgument<std::string>('m', "seeds", "", strSeeds);
+
+		cACLAP.AddFlag('a', "seeds-stats", "", bSeedStatistics);
+
+		cACLAP.AddArgument<std::string>('b', "fsm-batch", "", strBatchFile);
+
+		cACLAP.AddArgument<std::string>('o', "batch-output", "", strBatchOutput);
+
+		cACLAP.AddArgument<std::string>('B', "fsm-binary", "", strFsmBinary);
+
+		cACLAP.AddArgument<UInt32>('I', "fsm-index", "", unFsmIndex);
+
+		// Kept as a string, as any value of the bound is legitimate.
+		cACLAP.AddArgument<std::string>('k', "score-bound", "", strScoreBound);
+
+		cACLAP.AddArgument<UInt32>('i', "score-bound-interval", "", sSettings.ScoreBoundInterval);
+
+		cACLAP.AddArgument<Real>('w', "score-bound-rate", "", sSettings.ScoreBoundRate);
+
+		cACLAP.AddArgument<std::string>('x', "cache", "", strCacheFile);
+
+		cACLAP.AddArgument<UInt32>('y', "cache-size", "", unCacheSize);
+
+		cACLAP.AddFlag('g', "cache-stats", "", bCacheStatistics);
+
+		cACLAP.AddFlag('p', "profile", "", bProfile);
+
+		cACLAP.AddFlag('j', "selective-loading", "", bSelectiveLoading);
+
+		cACLAP.AddFlag('E', "swarm-engine", "", bSwarmEngine);
+
 		// Parse command line without taking the configuration of the FSM into account
 		cACLAP.Parse(n_argc, ppch_argv);
 
+		bServe = bServe || sSettings.Fork || !strServeSocket.empty();
+
+		if (bProfile) {
+			sSettings.Profile = &sProfile;
+		}
+		Real fPhaseStart = GetWallClock();
+
+		if (!strScoreBound.empty()) {
+			sSettings.UseScoreBound = true;
+			sSettings.ScoreBound = strtod(strScoreBound.c_str(), NULL);
+		}
+
 		CSimulator& cSimulator = CSimulator::GetInstance();
 
 		switch(cACLAP.GetAction()) {
     	case CARGoSCommandLineArgParser::ACTION_RUN_EXPERIMENT: {
-				CDynamicLoading::LoadAllLibraries();
-				cSimulator.SetExperimentFileName(cACLAP.GetExperimentConfigFile());
+				if (!bFsmControllerFound && !bServe && strBatchFile.empty() && strFsmBinary.empty()) {
+					THROW_ARGOSEXCEPTION(ExplainParameters());
+				}
 
-				// Creation of the finite state machine.
+				// A single configuration is parsed (or loaded) and checked before anything else is loaded.
+				AutoMoDeFsmConfig cFsmConfig;
+				if (!bServe && strBatchFile.empty()) {
+					if (!strFsmBinary.empty()) {
+						AutoMoDeFsmBinary(strFsmBinary).Load(unFsmIndex, cFsmConfig);
+					}
+					try {
+						if (strFsmBinary.empty()) {
+							cFsmConfig.Parse(strFullFsmConfig);
+						}
+						ValidateFsmConfig(cFsmConfig);
+					} catch (CARGoSException& ex) {
+						LOGERR << ex.what() << std::endl;
+#ifdef ARGOS_THREADSAFE_LOG
+						LOG.Flush();
+						LOGERR.Flush();
+#endif
+						return INVALID_FSM_EXIT_CODE;
+					}
+				}
 
-				AutoMoDeFsmBuilder cBuilder = AutoMoDeFsmBuilder();
-				// AutoMoDeFiniteStateMachine* pcFiniteStateMachine = cBuilder.BuildFiniteStateMachine(vecConfigFsm);
+				fPhaseStart = GetWallClock();
+				bool bSelectivelyLoaded = false;
+				if (bSelectiveLoading) {
+					bSelectivelyLoaded = LoadReferencedLibraries(cACLAP.GetExperimentConfigFile());
+				} else {
+					CDynamicLoading::LoadAllLibraries();
+				}
+				sProfile.LoadLibraries = GetWallClock() - fPhaseStart;
+				cSimulator.SetExperimentFileName(cACLAP.GetExperimentConfigFile());
 
 				// If the URL of the finite state machine is requested, display it.
 				if (bReadableFSM) {
@@ -102,36 +1054,100 @@ int main(int n_argc, char** ppch_argv) {
 					// std::cout << pcFiniteStateMachine->GetReadableFormat() << std::endl;
 				}
 
+				// With a list of seeds, the experiment is loaded with the first one.
+				if (!strSeeds.empty()) {
+					vecSeeds = ParseSeedList(strSeeds);
+					unSeed = vecSeeds.front();
+				}
+
 				// Setting random seed. Only works with modified version of ARGoS3.
 				cSimulator.SetRandomSeed(unSeed);
 
-				cSimulator.LoadExperiment();
-
-				// Duplicate the finite state machine and pass it to all robots.
-				CSpace::TMapPerType cEntities = cSimulator.GetSpace().GetEntitiesByType("controller");
-				for (CSpace::TMapPerType::iterator it = cEntities.begin(); it != cEntities.end(); ++it) {
-					CControllableEntity* pcEntity = any_cast<CControllableEntity*>(it->second);
-					AutoMoDeController& cController0 = dynamic_cast<AutoMoDeController&> (pcEntity->GetController());
-					UInt8 unRobotId = cController0.GetRobotNumericId();
-					std::string strGroupFsmConfig = cController0.ExtractGroupFsmConfig(strFullFsmConfig, unRobotId);
-					AutoMoDeFiniteStateMachine* pcFiniteStateMachine = cBuilder.BuildFiniteStateMachine(strGroupFsmConfig);
-					AutoMoDeFiniteStateMachine* pcPersonalFsm = new AutoMoDeFiniteStateMachine(pcFiniteStateMachine);
-					vecFsm.push_back(pcPersonalFsm);
-					try {
-						AutoMoDeController& cController = dynamic_cast<AutoMoDeController&> (pcEntity->GetController());
-						cController.SetFiniteStateMachine(pcPersonalFsm);
-						cController.SetHistoryFlag(bHistory);
-					} catch (std::exception& ex) {
-						LOGERR << "Error while casting: " << ex.what() << std::endl;
+				fPhaseStart = GetWallClock();
+				try {
+					cSimulator.LoadExperiment();
+				} catch (std::exception& ex) {
+					if (!bSelectivelyLoaded) {
+						throw;
+					}
+					// A plugin was missing: start again with all the libraries.
+					LOGERR << "[WARNING] The experiment could not be loaded with the libraries it refers to, loading all the libraries: " << ex.what() << std::endl;
+					cSimulator.Destroy();
+					CDynamicLoading::LoadAllLibraries();
+					cSimulator.SetExperimentFileName(cACLAP.GetExperimentConfigFile());
+					cSimulator.SetRandomSeed(unSeed);
+					cSimulator.LoadExperiment();
+				}
+				sProfile.LoadExperiment = GetWallClock() - fPhaseStart;
+
+				if (bSwarmEngine) {
+					sSettings.Engine = new AutoMoDeSwarmEngine();
+					sSettings.Engine->Attach(cSimulator);
+				}
+
+				if (!strCacheFile.empty()) {
+					AutoMoDeHash cInstanceHash;
+					cInstanceHash.UpdateWithFile(cACLAP.GetExperimentConfigFile());
+					sSettings.Instance = cInstanceHash.GetDigest();
+					sSettings.Cache = new AutoMoDeEvaluationCache(strCacheFile, unCacheSize);
+				}
+
+				if (bServe) {
+					// The libraries and the experiment are loaded once for all the jobs.
+					if (sSettings.Fork && cSimulator.GetNumThreads() > 0) {
+						THROW_ARGOSEXCEPTION("--fork-server requires an experiment without threads: only the forking thread survives in the children.");
 					}
+					if (strServeSocket.empty()) {
+						ServeJobs(stdin, stdout, cSimulator, sSettings, sSwarm);
+					} else {
+						ServeSocket(strServeSocket, cSimulator, sSettings, sSwarm);
+					}
+					break;
+				}
+
+				if (!strBatchFile.empty()) {
+					FILE* ptBatchOutput = stdout;
+					if (!strBatchOutput.empty()) {
+						ptBatchOutput = fopen(strBatchOutput.c_str(), "a");
+						if (ptBatchOutput == NULL) {
+							THROW_ARGOSEXCEPTION("Error opening file \"" << strBatchOutput << "\"");
+						}
+					}
+					RunBatch(strBatchFile, ptBatchOutput, cSimulator, unSeed, sSettings, sSwarm);
+					if (ptBatchOutput != stdout) {
+						fclose(ptBatchOutput);
+					}
+					break;
 				}
 
-				cSimulator.Execute();
+				// The finite state machine of each group is built once.
+				AutoMoDeFsmTemplates cTemplates(cFsmConfig);
+
+				if (!vecSeeds.empty()) {
+					SetUpSwarm(cSimulator, cTemplates, sSettings, sSwarm);
+					RunSeeds(cSimulator, cTemplates, vecSeeds, bSeedStatistics, sSettings);
+					break;
+				}
+
+				// The experiment loaded with the seed is only simulated if the result is not cached.
+				SEvaluationResult sResult;
+				SAutoMoDeDigest sKey;
+				bool bCached = false;
+				if (sSettings.Cache != NULL) {
+					sKey = ComputeEvaluationKey(cSimulator, unSeed, cTemplates, sSettings);
+					bCached = LookupResult(sKey, sSettings, sResult);
+				}
+				if (!bCached) {
+					// Creation of the finite state machines and distribution to all robots.
+					SetUpSwarm(cSimulator, cTemplates, sSettings, sSwarm);
 
-				// Retrieval of the score of the swarm driven by the Finite State Machine
-				CoreLoopFunctions& cLoopFunctions = dynamic_cast<CoreLoopFunctions&> (cSimulator.GetLoopFunctions());
-				Real fObjectiveFunction = cLoopFunctions.GetObjectiveFunction();
-				std::cout << "Score " << fObjectiveFunction << std::endl;
+					// Retrieval of the score of the swarm driven by the Finite State Machine
+					sResult = RunExperiment(cSimulator, sSettings);
+					if (sSettings.Cache != NULL) {
+						sSettings.Cache->Insert(sKey, sResult.Score, sResult.Capped);
+					}
+				}
+				std::cout << "Score " << FormatResult(sResult) << std::endl;
 
 				break;
 			}
@@ -151,7 +1167,26 @@ int main(int n_argc, char** ppch_argv) {
         break;
 		}
 
+		fPhaseStart = GetWallClock();
+		// The simulator deletes its loop functions: those of the experiment are given back first.
+		if (sSettings.Engine != NULL) {
+			sSettings.Engine->Clear();
+			sSettings.Engine->Detach();
+			delete sSettings.Engine;
+			sSettings.Engine = NULL;
+		}
 		cSimulator.Destroy();
+		sProfile.Destroy = GetWallClock() - fPhaseStart;
+
+		if (bProfile && cACLAP.GetAction() == CARGoSCommandLineArgParser::ACTION_RUN_EXPERIMENT) {
+			// Serving and batch outputs are left untouched.
+			std::ostream& cProfileOutput = (bServe || !strBatchFile.empty()) ? std::cerr : std::cout;
+			cProfileOutput << FormatProfile(sProfile) << std::endl;
+		}
+
+		if (sSettings.Cache != NULL && bCacheStatistics) {
+			std::cerr << sSettings.Cache->GetStatistics() << std::endl;
+		}
 
 	} catch(std::exception& ex) {
     // A fatal error occurred: dispose of data, print error and exit
@@ -163,9 +1198,8 @@ int main(int n_argc, char** ppch_argv) {
     return 1;
   }
 
-	for (unsigned int i = 0; i < vecFsm.size(); ++i) {
-		delete vecFsm.at(i);
-	}
+	ReleaseFiniteStateMachines(sSwarm.Fsm, sSwarm.Arenas[sSwarm.CurrentArena]);
+	delete sSettings.Cache;
 
 
 	/* Everything's ok, exit */
@@ -176,4 +1210,3 @@ int main(int n_argc, char** ppch_argv) {
 void SetRobotId(unsigned int un_robot_id) {
 		UInt8 m_unRobotId = un_robot_id;
 	}
-
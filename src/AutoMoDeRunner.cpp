@@ -0,0 +1,424 @@
+/*
+ * @file <src/AutoMoDeRunner.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief Target runner for irace. Evaluates finite state machines with
+ * 				automode_main, without going through a shell, and reports their
+ * 				cost along with the CPU time they took, as expected by irace when
+ * 				its budget is given in time (maxTime).
+ *
+ * 				automode_runner CONFIG_ID INSTANCE_ID SEED INSTANCE CONF...
+ * 				  Evaluates a single configuration and prints "COST TIME".
+ *
+ * 				automode_runner --batch FILE
+ * 				  Evaluates the jobs of FILE, one "CONFIG_ID INSTANCE_ID SEED INSTANCE CONF..."
+ * 				  per line, and prints one "COST TIME" line per job, in the same order.
+ * 				  The jobs sharing their instance and seed are evaluated by a single
+ * 				  automode_main process (see --fsm-batch), whose CPU time is shared
+ * 				  evenly between them. Up to one process per processor runs at once.
+ *
+ * 				Environment:
+ * 				  AUTOMODE_MAIN             Path to automode_main (default: next to automode_runner).
+ * 				  AUTOMODE_RUNNER_OPTIONS   Additional options given to automode_main.
+ * 				  AUTOMODE_RUNNER_JOBS      Number of processes run at once in batch mode.
+ */
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace argos;
+
+/*
+ * A job, as handed over by irace.
+ */
+struct SJob {
+	std::string ConfigurationId;
+	std::string InstanceId;
+	std::string Seed;
+	std::string Instance;
+	std::string FsmConfig;
+	/* Results. */
+	bool Done;
+	Real Cost;
+	Real Time;
+	std::string Error;
+
+	SJob() :
+		Done(false),
+		Cost(0),
+		Time(0) {}
+};
+
+/*
+ * A process running automode_main on a group of jobs.
+ */
+struct SProcess {
+	pid_t Pid;
+	std::vector<UInt32> Jobs;
+	std::string InputFile;
+	std::string OutputFile;
+};
+
+/*
+ * Splits a string on white spaces.
+ */
+std::vector<std::string> SplitWords(const std::string& str_line) {
+	std::vector<std::string> vecWords;
+	std::istringstream issLine(str_line);
+	std::string strWord;
+	while (issLine >> strWord) {
+		vecWords.push_back(strWord);
+	}
+	return vecWords;
+}
+
+/*
+ * Returns the path to automode_main: the value of AUTOMODE_MAIN if set, or the
+ * automode_main found in the directory of the running executable.
+ */
+std::string GetAutoMoDeMainPath() {
+	const char* pchPath = getenv("AUTOMODE_MAIN");
+	if (pchPath != NULL && pchPath[0] != '\0') {
+		return pchPath;
+	}
+	char pchExecutable[4096];
+	ssize_t nLength = readlink("/proc/self/exe", pchExecutable, sizeof(pchExecutable) - 1);
+	if (nLength <= 0) {
+		THROW_ARGOSEXCEPTION("Could not find automode_main, set AUTOMODE_MAIN");
+	}
+	std::string strExecutable(pchExecutable, nLength);
+	return strExecutable.substr(0, strExecutable.rfind('/') + 1) + "automode_main";
+}
+
+/*
+ * Starts automode_main with the given arguments. Its standard output goes to the file
+ * descriptor n_output, and its standard input is closed.
+ */
+pid_t StartAutoMoDeMain(const std::vector<std::string>& vec_arguments, int n_output) {
+	std::string strPath = GetAutoMoDeMainPath();
+	std::vector<char*> vecArgv;
+	vecArgv.push_back(const_cast<char*>(strPath.c_str()));
+	for (UInt32 i = 0; i < vec_arguments.size(); ++i) {
+		vecArgv.push_back(const_cast<char*>(vec_arguments.at(i).c_str()));
+	}
+	vecArgv.push_back(NULL);
+
+	fflush(NULL);
+	pid_t nPid = fork();
+	if (nPid < 0) {
+		THROW_ARGOSEXCEPTION("Could not start " << strPath);
+	}
+	if (nPid == 0) {
+		dup2(n_output, STDOUT_FILENO);
+		close(n_output);
+		int nNull = open("/dev/null", O_RDONLY);
+		if (nNull >= 0) {
+			dup2(nNull, STDIN_FILENO);
+			close(nNull);
+		}
+		execv(strPath.c_str(), &vecArgv[0]);
+		fprintf(stderr, "Could not execute %s: %s\n", strPath.c_str(), strerror(errno));
+		_exit(127);
+	}
+	return nPid;
+}
+
+/*
+ * Returns the arguments of automode_main common to all the jobs on (INSTANCE, SEED).
+ */
+std::vector<std::string> GetCommonArguments(const std::string& str_instance, const std::string& str_seed) {
+	std::vector<std::string> vecArguments;
+	vecArguments.push_back("-n");
+	vecArguments.push_back("-c");
+	vecArguments.push_back(str_instance);
+	vecArguments.push_back("--seed");
+	vecArguments.push_back(str_seed);
+	const char* pchOptions = getenv("AUTOMODE_RUNNER_OPTIONS");
+	if (pchOptions != NULL) {
+		std::vector<std::string> vecOptions = SplitWords(pchOptions);
+		vecArguments.insert(vecArguments.end(), vecOptions.begin(), vecOptions.end());
+	}
+	return vecArguments;
+}
+
+/*
+ * Waits for a process and returns the CPU time it used, in seconds.
+ * Throws if the process did not end normally.
+ */
+Real WaitForProcess(pid_t n_pid, pid_t* pn_ended = NULL) {
+	int nStatus = 0;
+	struct rusage sUsage;
+	pid_t nEnded;
+	while ((nEnded = wait4(n_pid, &nStatus, 0, &sUsage)) < 0 && errno == EINTR) {}
+	if (nEnded < 0) {
+		THROW_ARGOSEXCEPTION("Could not wait for automode_main");
+	}
+	if (pn_ended != NULL) {
+		*pn_ended = nEnded;
+	}
+	if (WIFSIGNALED(nStatus)) {
+		THROW_ARGOSEXCEPTION("automode_main was killed by signal " << WTERMSIG(nStatus));
+	}
+	if (!WIFEXITED(nStatus) || WEXITSTATUS(nStatus) != 0) {
+		THROW_ARGOSEXCEPTION("automode_main failed with status " << WEXITSTATUS(nStatus));
+	}
+	return sUsage.ru_utime.tv_sec + sUsage.ru_utime.tv_usec * 1e-6
+		+ sUsage.ru_stime.tv_sec + sUsage.ru_stime.tv_usec * 1e-6;
+}
+
+/*
+ * Parses a number at the start of str_text. Returns false if there is none.
+ */
+bool ParseNumber(const std::string& str_text, Real& f_value) {
+	const char* pchStart = str_text.c_str();
+	char* pchEnd = NULL;
+	f_value = strtod(pchStart, &pchEnd);
+	return pchEnd != pchStart;
+}
+
+/*
+ * Evaluates a single job and prints "COST TIME".
+ */
+void RunSingleJob(const SJob& s_job) {
+	std::vector<std::string> vecArguments = GetCommonArguments(s_job.Instance, s_job.Seed);
+	vecArguments.push_back("--fsm-config");
+	std::vector<std::string> vecFsmConfig = SplitWords(s_job.FsmConfig);
+	vecArguments.insert(vecArguments.end(), vecFsmConfig.begin(), vecFsmConfig.end());
+
+	int pnPipe[2];
+	if (pipe(pnPipe) != 0) {
+		THROW_ARGOSEXCEPTION("Could not create the pipe to automode_main");
+	}
+	pid_t nPid = StartAutoMoDeMain(vecArguments, pnPipe[1]);
+	close(pnPipe[1]);
+
+	std::string strOutput;
+	char pchBuffer[4096];
+	ssize_t nBytes;
+	while ((nBytes = read(pnPipe[0], pchBuffer, sizeof(pchBuffer))) != 0) {
+		if (nBytes < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		strOutput.append(pchBuffer, nBytes);
+	}
+	close(pnPipe[0]);
+	Real fTime = WaitForProcess(nPid);
+
+	size_t unScore = strOutput.find("Score ");
+	Real fCost;
+	if (unScore == std::string::npos || !ParseNumber(strOutput.substr(unScore + 6), fCost)) {
+		THROW_ARGOSEXCEPTION("The output of automode_main does not contain a score");
+	}
+	std::cout.precision(15);
+	std::cout << fCost << " " << fTime << std::endl;
+}
+
+/*
+ * Reads the jobs of a batch file.
+ */
+std::vector<SJob> ReadJobs(const std::string& str_batch_file) {
+	std::ifstream cBatchFile(str_batch_file.c_str());
+	if (cBatchFile.fail()) {
+		THROW_ARGOSEXCEPTION("Error opening file \"" << str_batch_file << "\"");
+	}
+	std::vector<SJob> vecJobs;
+	std::string strLine;
+	while (std::getline(cBatchFile, strLine)) {
+		std::istringstream issLine(strLine);
+		SJob sJob;
+		if (!(issLine >> sJob.ConfigurationId)) {
+			continue;
+		}
+		if (!(issLine >> sJob.InstanceId >> sJob.Seed >> sJob.Instance)) {
+			THROW_ARGOSEXCEPTION("Invalid job \"" << strLine << "\" in " << str_batch_file);
+		}
+		std::getline(issLine, sJob.FsmConfig);
+		vecJobs.push_back(sJob);
+	}
+	return vecJobs;
+}
+
+/*
+ * Starts automode_main on the jobs of the group, given to it as an --fsm-batch file.
+ */
+SProcess StartGroup(std::vector<SJob>& vec_jobs, const std::vector<UInt32>& vec_group) {
+	SProcess sProcess;
+	sProcess.Jobs = vec_group;
+
+	char pchInputFile[] = "/tmp/automode_runner_XXXXXX";
+	int nInput = mkstemp(pchInputFile);
+	char pchOutputFile[] = "/tmp/automode_runner_XXXXXX";
+	int nOutput = mkstemp(pchOutputFile);
+	if (nInput < 0 || nOutput < 0) {
+		THROW_ARGOSEXCEPTION("Could not create the temporary files of the batch");
+	}
+	sProcess.InputFile = pchInputFile;
+	sProcess.OutputFile = pchOutputFile;
+
+	std::ostringstream ossInput;
+	for (UInt32 i = 0; i < vec_group.size(); ++i) {
+		ossInput << vec_jobs.at(vec_group.at(i)).FsmConfig << "\n";
+	}
+	std::string strInput = ossInput.str();
+	if (write(nInput, strInput.c_str(), strInput.size()) != (ssize_t) strInput.size()) {
+		THROW_ARGOSEXCEPTION("Could not write the batch file " << sProcess.InputFile);
+	}
+	close(nInput);
+
+	SJob& sFirstJob = vec_jobs.at(vec_group.front());
+	std::vector<std::string> vecArguments = GetCommonArguments(sFirstJob.Instance, sFirstJob.Seed);
+	vecArguments.push_back("--fsm-batch");
+	vecArguments.push_back(sProcess.InputFile);
+	sProcess.Pid = StartAutoMoDeMain(vecArguments, nOutput);
+	close(nOutput);
+	return sProcess;
+}
+
+/*
+ * Collects the "LINE SCORE" records of a group, once its process has ended.
+ */
+void CollectGroup(std::vector<SJob>& vec_jobs, const SProcess& s_process, Real f_time, const std::string& str_error) {
+	std::ifstream cOutput(s_process.OutputFile.c_str());
+	std::string strLine;
+	while (str_error.empty() && std::getline(cOutput, strLine)) {
+		std::istringstream issRecord(strLine);
+		UInt32 unLine;
+		std::string strResult;
+		if (!(issRecord >> unLine) || unLine < 1 || unLine > s_process.Jobs.size()) {
+			continue;
+		}
+		std::getline(issRecord, strResult);
+		strResult.erase(0, strResult.find_first_not_of(' '));
+		SJob& sJob = vec_jobs.at(s_process.Jobs.at(unLine - 1));
+		if (ParseNumber(strResult, sJob.Cost)) {
+			sJob.Done = true;
+		} else {
+			sJob.Error = (strResult.compare(0, 6, "Error ") == 0) ? strResult.substr(6) : strResult;
+		}
+	}
+
+	for (UInt32 i = 0; i < s_process.Jobs.size(); ++i) {
+		SJob& sJob = vec_jobs.at(s_process.Jobs.at(i));
+		sJob.Time = f_time / s_process.Jobs.size();
+		if (!sJob.Done && sJob.Error.empty()) {
+			sJob.Error = str_error.empty() ? "No result" : str_error;
+		}
+	}
+	unlink(s_process.InputFile.c_str());
+	unlink(s_process.OutputFile.c_str());
+}
+
+/*
+ * Evaluates the jobs of a batch file and prints one "COST TIME" line per job.
+ * Returns false if a job failed: its line is then "Error MESSAGE".
+ */
+bool RunBatch(const std::string& str_batch_file) {
+	std::vector<SJob> vecJobs = ReadJobs(str_batch_file);
+
+	// Groups of jobs sharing their instance and seed, in the order of their first job.
+	std::vector<std::vector<UInt32> > vecGroups;
+	std::map<std::pair<std::string, std::string>, UInt32> mapGroups;
+	for (UInt32 i = 0; i < vecJobs.size(); ++i) {
+		std::pair<std::string, std::string> cKey(vecJobs.at(i).Instance, vecJobs.at(i).Seed);
+		std::map<std::pair<std::string, std::string>, UInt32>::iterator it = mapGroups.find(cKey);
+		if (it == mapGroups.end()) {
+			it = mapGroups.insert(std::make_pair(cKey, (UInt32) vecGroups.size())).first;
+			vecGroups.push_back(std::vector<UInt32>());
+		}
+		vecGroups.at(it->second).push_back(i);
+	}
+
+	long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+	UInt32 unMaxProcesses = nProcessors > 0 ? nProcessors : 1;
+	const char* pchJobs = getenv("AUTOMODE_RUNNER_JOBS");
+	if (pchJobs != NULL && atoi(pchJobs) > 0) {
+		unMaxProcesses = atoi(pchJobs);
+	}
+
+	std::map<pid_t, SProcess> mapRunning;
+	UInt32 unNextGroup = 0;
+	while (unNextGroup < vecGroups.size() || !mapRunning.empty()) {
+		while (unNextGroup < vecGroups.size() && mapRunning.size() < unMaxProcesses) {
+			SProcess sProcess = StartGroup(vecJobs, vecGroups.at(unNextGroup++));
+			mapRunning[sProcess.Pid] = sProcess;
+		}
+		pid_t nEnded = -1;
+		Real fTime = 0;
+		std::string strError;
+		try {
+			fTime = WaitForProcess(-1, &nEnded);
+		} catch (CARGoSException& ex) {
+			strError = ex.what();
+		}
+		std::map<pid_t, SProcess>::iterator it = mapRunning.find(nEnded);
+		if (it == mapRunning.end()) {
+			if (nEnded < 0) {
+				THROW_ARGOSEXCEPTION(strError);
+			}
+			continue;
+		}
+		CollectGroup(vecJobs, it->second, fTime, strError);
+		mapRunning.erase(it);
+	}
+
+	bool bSuccess = true;
+	std::cout.precision(15);
+	for (UInt32 i = 0; i < vecJobs.size(); ++i) {
+		if (vecJobs.at(i).Done) {
+			std::cout << vecJobs.at(i).Cost << " " << vecJobs.at(i).Time << std::endl;
+		} else {
+			std::cout << "Error " << vecJobs.at(i).Error << std::endl;
+			bSuccess = false;
+		}
+	}
+	return bSuccess;
+}
+
+/**
+ * @brief
+ *
+ */
+int main(int n_argc, char** ppch_argv) {
+	try {
+		if (n_argc == 3 && strcmp(ppch_argv[1], "--batch") == 0) {
+			return RunBatch(ppch_argv[2]) ? 0 : 1;
+		}
+		if (n_argc < 6) {
+			THROW_ARGOSEXCEPTION("Usage: " << ppch_argv[0] << " CONFIG_ID INSTANCE_ID SEED INSTANCE CONF... | --batch FILE");
+		}
+		SJob sJob;
+		sJob.ConfigurationId = ppch_argv[1];
+		sJob.InstanceId = ppch_argv[2];
+		sJob.Seed = ppch_argv[3];
+		sJob.Instance = ppch_argv[4];
+		for (int i = 5; i < n_argc; ++i) {
+			sJob.FsmConfig += std::string(ppch_argv[i]) + " ";
+		}
+		RunSingleJob(sJob);
+	} catch (std::exception& ex) {
+		std::cerr << "error: " << ex.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -5,9 +5,17 @@ link_directories(${ARGOS_LIBRARY_DIRS})
 # Headers
 set(AUTOMODE_HEADERS
 	core/AutoMoDeController.h
+	core/AutoMoDeArena.h
 	core/AutoMoDeFiniteStateMachine.h
+	core/AutoMoDeFsmBinary.h
 	core/AutoMoDeFsmBuilder.h
+	core/AutoMoDeFsmConfig.h
+	core/AutoMoDeFsmTemplates.h
+	core/AutoMoDeFsmValidator.h
+	core/AutoMoDeGroupAssignment.h
 	core/AutoMoDeFsmHistory.h
+	core/AutoMoDeHash.h
+	core/AutoMoDeModuleCatalogue.h
 	# Behaviours
 	modules/AutoMoDeBehaviour.h
 	modules/AutoMoDeBehaviourAntiPhototaxis.h
@@ -18,6 +26,9 @@ set(AUTOMODE_HEADERS
 	modules/AutoMoDeBehaviourExploration.h
     modules/AutoMoDeBehaviourGoToColor.h
     modules/AutoMoDeBehaviourGoAwayColor.h
+	# Parameters
+	modules/AutoMoDeParameters.h
+	modules/AutoMoDeRandomStream.h
 	# Conditions
 	modules/AutoMoDeCondition.h
 	modules/AutoMoDeConditionBlackFloor.h
@@ -31,9 +42,17 @@ set(AUTOMODE_HEADERS
 # Sources
 set(AUTOMODE_SOURCES
 	core/AutoMoDeController.cpp
+	core/AutoMoDeArena.cpp
 	core/AutoMoDeFiniteStateMachine.cpp
+	core/AutoMoDeFsmBinary.cpp
 	core/AutoMoDeFsmBuilder.cpp
+	core/AutoMoDeFsmConfig.cpp
+	core/AutoMoDeFsmTemplates.cpp
+	core/AutoMoDeFsmValidator.cpp
+	core/AutoMoDeGroupAssignment.cpp
 	core/AutoMoDeFsmHistory.cpp
+	core/AutoMoDeHash.cpp
+	core/AutoMoDeModuleCatalogue.cpp
 	# Behaviours
 	modules/AutoMoDeBehaviour.cpp
 	modules/AutoMoDeBehaviourAntiPhototaxis.cpp
@@ -44,6 +63,9 @@ set(AUTOMODE_SOURCES
 	modules/AutoMoDeBehaviourExploration.cpp
     modules/AutoMoDeBehaviourGoToColor.cpp
     modules/AutoMoDeBehaviourGoAwayColor.cpp
+	# Parameters
+	modules/AutoMoDeParameters.cpp
+	modules/AutoMoDeRandomStream.cpp
 	# Conditions
 	modules/AutoMoDeCondition.cpp
 	modules/AutoMoDeConditionBlackFloor.cpp
@@ -5,9 +5,19 @@ link_directories(${ARGOS_LIBRARY_DIRS})
 # Headers
 set(AUTOMODE_HEADERS
 	core/AutoMoDeController.h
+	core/AutoMoDeArena.h
 	core/AutoMoDeFiniteStateMachine.h
+	core/AutoMoDeFsmBinary.h
 	core/AutoMoDeFsmBuilder.h
+	core/AutoMoDeFsmConfig.h
+	core/AutoMoDeFsmTemplates.h
+	core/AutoMoDeFsmValidator.h
+	core/AutoMoDeGroupAssignment.h
 	core/AutoMoDeFsmHistory.h
+	core/AutoMoDeHash.h
+	core/AutoMoDeModuleCatalogue.h
+	core/AutoMoDeEvaluationCache.h
+	core/AutoMoDeSwarmEngine.h
 	# Behaviours
 	modules/AutoMoDeBehaviour.h
 	modules/AutoMoDeBehaviourAntiPhototaxis.h
@@ -18,6 +28,9 @@ set(AUTOMODE_HEADERS
 	modules/AutoMoDeBehaviourExploration.h
     modules/AutoMoDeBehaviourGoToColor.h
     modules/AutoMoDeBehaviourGoAwayColor.h
+	# Parameters
+	modules/AutoMoDeParameters.h
+	modules/AutoMoDeRandomStream.h
 	# Conditions
 	modules/AutoMoDeCondition.h
 	modules/AutoMoDeConditionBlackFloor.h
@@ -31,9 +44,19 @@ set(AUTOMODE_HEADERS
 # Sources
 set(AUTOMODE_SOURCES
 	core/AutoMoDeController.cpp
+	core/AutoMoDeArena.cpp
 	core/AutoMoDeFiniteStateMachine.cpp
+	core/AutoMoDeFsmBinary.cpp
 	core/AutoMoDeFsmBuilder.cpp
+	core/AutoMoDeFsmConfig.cpp
+	core/AutoMoDeFsmTemplates.cpp
+	core/AutoMoDeFsmValidator.cpp
+	core/AutoMoDeGroupAssignment.cpp
 	core/AutoMoDeFsmHistory.cpp
+	core/AutoMoDeHash.cpp
+	core/AutoMoDeModuleCatalogue.cpp
+	core/AutoMoDeEvaluationCache.cpp
+	core/AutoMoDeSwarmEngine.cpp
 	# Behaviours
 	modules/AutoMoDeBehaviour.cpp
 	modules/AutoMoDeBehaviourAntiPhototaxis.cpp
@@ -44,6 +67,9 @@ set(AUTOMODE_SOURCES
 	modules/AutoMoDeBehaviourExploration.cpp
     modules/AutoMoDeBehaviourGoToColor.cpp
     modules/AutoMoDeBehaviourGoAwayColor.cpp
+	# Parameters
+	modules/AutoMoDeParameters.cpp
+	modules/AutoMoDeRandomStream.cpp
 	# Conditions
 	modules/AutoMoDeCondition.cpp
 	modules/AutoMoDeConditionBlackFloor.cpp
@@ -55,6 +81,13 @@ set(AUTOMODE_SOURCES
     modules/AutoMoDeConditionProbColor.cpp)
 
 
+# The random streams compute the blocks of 8 ticks at once with AVX2 when enabled. The
+# library then only runs on processors supporting AVX2; the e-puck build never uses it.
+option(AUTOMODE_AVX2 "Compile the random streams of the simulated robots with AVX2" OFF)
+if(AUTOMODE_AVX2)
+  set_source_files_properties(modules/AutoMoDeRandomStream.cpp PROPERTIES COMPILE_FLAGS -mavx2)
+endif(AUTOMODE_AVX2)
+
 add_library(automode SHARED ${AUTOMODE_HEADERS} ${AUTOMODE_SOURCES})
 target_link_libraries(automode argos3plugin_${ARGOS_BUILD_FOR}_epuck)
 
@@ -62,5 +95,34 @@ set(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_SOURCE_DIR}/bin)
 add_executable(automode_main AutoMoDeMain.cpp)
 target_link_libraries(automode_main automode argos3core_${ARGOS_BUILD_FOR} argos3plugin_${ARGOS_BUILD_FOR}_epuck argos3_demiurge_loop_functions argos3_demiurge_epuck_dao)
 
+add_executable(automode_runner AutoMoDeRunner.cpp)
+target_link_libraries(automode_runner argos3core_${ARGOS_BUILD_FOR})
+
+add_executable(automode_compile_fsm AutoMoDeCompileFsm.cpp)
+target_link_libraries(automode_compile_fsm automode argos3core_${ARGOS_BUILD_FOR} argos3plugin_${ARGOS_BUILD_FOR}_epuck argos3_demiurge_epuck_dao)
+
 add_executable(visualize_fsm AutoMoDeVisualizeFSM.cpp)
 target_link_libraries(visualize_fsm automode argos3core_${ARGOS_BUILD_FOR} argos3plugin_${ARGOS_BUILD_FOR}_epuck argos3_demiurge_epuck_dao)
+
+#
+# Stress test: an experiment evaluated with threads="0" and with several threads must give
+# the same score and state histories. It needs an experiment with absolute paths, and an FSM
+# configuration for its groups.
+#
+set(AUTOMODE_TEST_EXPERIMENT "" CACHE FILEPATH "Experiment (.argos) of the thread determinism test")
+set(AUTOMODE_TEST_FSM_CONFIG "" CACHE STRING "FSM configuration of the thread determinism test")
+set(AUTOMODE_TEST_SEED 1 CACHE STRING "Seed of the thread determinism test")
+set(AUTOMODE_TEST_THREADS 4 CACHE STRING "Number of threads of the thread determinism test")
+if(AUTOMODE_TEST_EXPERIMENT AND AUTOMODE_TEST_FSM_CONFIG)
+  separate_arguments(AUTOMODE_TEST_FSM_ARGUMENTS UNIX_COMMAND "${AUTOMODE_TEST_FSM_CONFIG}")
+  add_test(NAME automode_thread_determinism
+    COMMAND ${CMAKE_CURRENT_SOURCE_DIR}/tests/thread_determinism.sh $<TARGET_FILE:automode_main> ${AUTOMODE_TEST_EXPERIMENT} ${AUTOMODE_TEST_SEED} ${AUTOMODE_TEST_THREADS} ${AUTOMODE_TEST_FSM_ARGUMENTS})
+endif(AUTOMODE_TEST_EXPERIMENT AND AUTOMODE_TEST_FSM_CONFIG)
+
+#
+# Steps the finite state machines of a few robots, as deep copies and as instances, and
+# fails if a step allocates memory.
+#
+add_executable(automode_step_allocations tests/AutoMoDeStepAllocations.cpp)
+target_link_libraries(automode_step_allocations automode argos3core_${ARGOS_BUILD_FOR} argos3plugin_${ARGOS_BUILD_FOR}_epuck argos3_demiurge_epuck_dao)
+add_test(NAME automode_step_allocations COMMAND $<TARGET_FILE:automode_step_allocations>)
@@ -6,6 +6,12 @@ execute_process(
   COMMAND tr -d '\n'
   OUTPUT_VARIABLE ARGOS_PROCESSOR_ARCH)
 
+#
+# Language standard
+#
+set(CMAKE_CXX_STANDARD 17)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
 #
 # General compilation flags
 #
@@ -0,0 +1,92 @@
+/*
+ * @file <src/core/AutoMoDeArena.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeArena.h"
+
+#include <new>
+
+namespace argos {
+
+	/* Alignment of the objects, enough for any scalar type. */
+	static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+	/*
+	 * Returns the number of bytes to skip from pch_memory to reach an address aligned on
+	 * un_alignment bytes.
+	 */
+	static size_t GetPadding(const char* pch_memory, size_t un_alignment) {
+		size_t unMisalignment = reinterpret_cast<size_t>(pch_memory) & (un_alignment - 1);
+		return (unMisalignment == 0 ? 0 : un_alignment - unMisalignment);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeArena::AutoMoDeArena(size_t un_block_size) :
+		m_unCurrentBlock(0),
+		m_unOffset(0),
+		m_unBlockSize(un_block_size) {}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeArena::~AutoMoDeArena() {
+		for (size_t i = 0; i < m_vecBlocks.size(); ++i) {
+			::operator delete(m_vecBlocks.at(i).Memory);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void* AutoMoDeArena::Allocate(size_t un_size) {
+		return Allocate(un_size, ALIGNMENT);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void* AutoMoDeArena::Allocate(size_t un_size, size_t un_alignment) {
+		if (un_alignment < ALIGNMENT) {
+			un_alignment = ALIGNMENT;
+		}
+		un_size = (un_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		// Blocks kept from before the last Clear() are used first.
+		while (m_unCurrentBlock < m_vecBlocks.size()) {
+			SBlock& sBlock = m_vecBlocks.at(m_unCurrentBlock);
+			size_t unPadding = GetPadding(sBlock.Memory + m_unOffset, un_alignment);
+			if (m_unOffset + unPadding + un_size <= sBlock.Size) {
+				void* pMemory = sBlock.Memory + m_unOffset + unPadding;
+				m_unOffset += unPadding + un_size;
+				return pMemory;
+			}
+			++m_unCurrentBlock;
+			m_unOffset = 0;
+		}
+		// Objects larger than a block get a block of their own. The memory of a block is
+		// aligned on ALIGNMENT bytes at least.
+		size_t unMaxSize = un_size + un_alignment - ALIGNMENT;
+		m_vecBlocks.reserve(m_vecBlocks.size() + 1);
+		SBlock sBlock;
+		sBlock.Size = (unMaxSize > m_unBlockSize ? unMaxSize : m_unBlockSize);
+		sBlock.Memory = static_cast<char*>(::operator new(sBlock.Size));
+		m_vecBlocks.push_back(sBlock);
+		m_unCurrentBlock = m_vecBlocks.size() - 1;
+		size_t unPadding = GetPadding(sBlock.Memory, un_alignment);
+		m_unOffset = unPadding + un_size;
+		return sBlock.Memory + unPadding;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeArena::Clear() {
+		m_unCurrentBlock = 0;
+		m_unOffset = 0;
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * @file <src/core/AutoMoDeArena.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class is a region allocator: objects are placed one after
+ * 				the other in large blocks of memory, and are all released at
+ * 				once. The blocks are kept when the arena is cleared, so that an
+ * 				arena reused for successive evaluations stops allocating after
+ * 				the first one. The arena does not call any destructor: the
+ * 				objects placed in it must be destroyed before it is cleared.
+ */
+
+#ifndef AUTOMODE_ARENA_H
+#define AUTOMODE_ARENA_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace argos {
+	class AutoMoDeArena {
+		public:
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeArena(size_t un_block_size = DEFAULT_BLOCK_SIZE);
+
+			/*
+			 * Class destructor. Frees the blocks.
+			 */
+			virtual ~AutoMoDeArena();
+
+			/*
+			 * Returns memory for an object of un_size bytes, aligned for any type.
+			 */
+			void* Allocate(size_t un_size);
+
+			/*
+			 * Same as above, aligned on un_alignment bytes, a power of two. Objects aligned on
+			 * CACHE_LINE_SIZE do not share a cache line with the objects placed before them.
+			 * An over-aligned type (alignas) is not enough: placement in the blocks only
+			 * follows the alignment asked here.
+			 */
+			void* Allocate(size_t un_size, size_t un_alignment);
+
+			/*
+			 * Releases all the objects placed in the arena at once.
+			 */
+			void Clear();
+
+			/*
+			 * Default size of the blocks, in bytes.
+			 */
+			static const size_t DEFAULT_BLOCK_SIZE = 65536;
+
+			/*
+			 * Size of a cache line, in bytes.
+			 */
+			static const size_t CACHE_LINE_SIZE = 64;
+
+		private:
+			/*
+			 * Copying would share the blocks.
+			 */
+			AutoMoDeArena(const AutoMoDeArena&);
+			AutoMoDeArena& operator=(const AutoMoDeArena&);
+
+			struct SBlock {
+				char* Memory;
+				size_t Size;
+			};
+
+			std::vector<SBlock> m_vecBlocks;
+
+			/*
+			 * The block objects are currently placed in, and the offset of its free space.
+			 */
+			size_t m_unCurrentBlock;
+			size_t m_unOffset;
+
+			size_t m_unBlockSize;
+	};
+}
+
+#endif
@@ -10,19 +10,66 @@
 
 #include "AutoMoDeController.h"
 
+#include <memory>
+#include <sys/stat.h>
+
 namespace argos {
 
 	/****************************************/
 	/****************************************/
 
+	/*
+	 * The robots of an experiment share their configuration: it is parsed (or loaded from
+	 * the compiled file str_fsm_binary), and the finite state machine of each group built,
+	 * for the first robot only. The templates of the last configuration met are kept until
+	 * another configuration is met, or until the end of the process. A compiled file is
+	 * identified by its path and by the identity of its content (device, inode, size and
+	 * modification time), so that a file compiled again is loaded again.
+	 */
+	static AutoMoDeFsmTemplates& GetFsmTemplates(const std::string& str_fsm_config, const std::string& str_fsm_binary, UInt32 un_fsm_index) {
+		static std::string strLastKey;
+		static std::unique_ptr<AutoMoDeFsmTemplates> pcLastFsmTemplates;
+		std::ostringstream ossKey;
+		if (str_fsm_binary.empty()) {
+			ossKey << "config " << str_fsm_config;
+		} else {
+			struct stat sStat;
+			if (stat(str_fsm_binary.c_str(), &sStat) != 0) {
+				THROW_ARGOSEXCEPTION("Error opening file \"" << str_fsm_binary << "\"");
+			}
+			ossKey << "binary " << un_fsm_index << " " << sStat.st_dev << " " << sStat.st_ino << " "
+				<< sStat.st_size << " " << sStat.st_mtime << " " << str_fsm_binary;
+		}
+		if (!pcLastFsmTemplates || ossKey.str() != strLastKey) {
+			pcLastFsmTemplates.reset();
+			if (str_fsm_binary.empty()) {
+				pcLastFsmTemplates.reset(new AutoMoDeFsmTemplates(str_fsm_config));
+			} else {
+				AutoMoDeFsmConfig cFsmConfig;
+				AutoMoDeFsmBinary(str_fsm_binary).Load(un_fsm_index, cFsmConfig);
+				pcLastFsmTemplates.reset(new AutoMoDeFsmTemplates(cFsmConfig));
+			}
+			strLastKey = ossKey.str();
+		}
+		return *pcLastFsmTemplates;
+	}
+
+	/****************************************/
+	/****************************************/
+
 	AutoMoDeController::AutoMoDeController() {
         m_pcRobotState = new ReferenceModel3Dot0();
 		m_unTimeStep = 0;
 		m_strFsmConfiguration = "";
+		m_strFsmBinary = "";
+		m_unFsmIndex = 0;
 		m_bMaintainHistory = false;
 		m_bPrintReadableFsm = false;
 		m_strHistoryFolder = "./";
 		m_bFiniteStateMachineGiven = false;
+		m_pcFiniteStateMachine = NULL;
+		m_pcConfiguredFiniteStateMachine = NULL;
+		m_bExternalStepping = false;
 	}
 
 	/****************************************/
@@ -30,9 +77,7 @@ namespace argos {
 
 	AutoMoDeController::~AutoMoDeController() {
 		delete m_pcRobotState;
-		if (m_strFsmConfiguration.compare("") != 0) {
-			delete m_pcFsmBuilder;
-		}
+		delete m_pcConfiguredFiniteStateMachine;
 	}
 
 	/****************************************/
@@ -42,6 +87,8 @@ namespace argos {
 		// Parsing parameters
 		try {
 			GetNodeAttributeOrDefault(t_node, "fsm-config", m_strFsmConfiguration, m_strFsmConfiguration);
+			GetNodeAttributeOrDefault(t_node, "fsm-binary", m_strFsmBinary, m_strFsmBinary);
+			GetNodeAttributeOrDefault(t_node, "fsm-index", m_unFsmIndex, m_unFsmIndex);
 			GetNodeAttributeOrDefault(t_node, "history", m_bMaintainHistory, m_bMaintainHistory);
 			GetNodeAttributeOrDefault(t_node, "hist-folder", m_strHistoryFolder, m_strHistoryFolder);
 			GetNodeAttributeOrDefault(t_node, "readable", m_bPrintReadableFsm, m_bPrintReadableFsm);
@@ -50,15 +97,16 @@ namespace argos {
 		}
 
 		m_unRobotID = GetRobotNumericId();
+		// Keys the random numbers of the robot, and names its history.
+		m_pcRobotState->SetRobotIdentifier(m_unRobotID);
 
 		/*
-		 * If a FSM configuration is given as parameter of the experiment file, create a FSM from it
+		 * If a FSM configuration is given as parameter of the experiment file, create a FSM from it.
+		 * A compiled file (fsm-binary) takes precedence over the text configuration (fsm-config).
 		 */
-		if (m_strFsmConfiguration.compare("") != 0 && !m_bFiniteStateMachineGiven) {
-			m_pcFsmBuilder = new AutoMoDeFsmBuilder();
-			std::string strGroupFsm = ExtractGroupFsmConfig(m_strFsmConfiguration, m_unRobotID);
-			// std::cout << "Robot id: "<< m_unRobotID << " FSM: " << strGroupFsm << std::endl;
-			SetFiniteStateMachine(m_pcFsmBuilder->BuildFiniteStateMachine(strGroupFsm));
+		if ((m_strFsmConfiguration.compare("") != 0 || m_strFsmBinary.compare("") != 0) && !m_bFiniteStateMachineGiven) {
+			m_pcConfiguredFiniteStateMachine = GetFsmTemplates(m_strFsmConfiguration, m_strFsmBinary, m_unFsmIndex).CreateFiniteStateMachine(m_unRobotID);
+			SetFiniteStateMachine(m_pcConfiguredFiniteStateMachine);
 			if (m_bMaintainHistory) {
 				m_pcFiniteStateMachine->SetHistoryFolder(m_strHistoryFolder);
 				m_pcFiniteStateMachine->MaintainHistory();
@@ -106,68 +154,26 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	std::string AutoMoDeController::ExtractGroupFsmConfig(const std::string& strFullConfig, UInt32 unRobotId) {
-		std::istringstream iss(strFullConfig);
-		std::vector<std::string> tokens;
-		std::string token;
-
-		// Tokenize input
-		while (iss >> token) {
-			tokens.push_back(token);
-		}
-
-		UInt32 unNumGroups = 0;
-		std::vector<UInt32> vecGroupSizes;
-
-		// First pass: extract group sizes
-		for (size_t i = 0; i < tokens.size(); ++i) {
-			if (tokens[i] == "--ngroups" && i + 1 < tokens.size()) {
-				unNumGroups = std::stoi(tokens[i + 1]);
-			} else if (tokens[i].substr(0, 3) == "--g") {
-				vecGroupSizes.push_back(std::stoi(tokens[i + 1]));
-			}
-		}
-
-		if (unNumGroups != vecGroupSizes.size()) {
-			throw std::runtime_error("Mismatch between --ngroups and number of --g<i> entries");
-		}
+	void AutoMoDeController::ControlStep() {
+		UpdateRobotState();
 
-		// Determine group index of the robot
-		UInt32 unGroupIndex = 0;
-		UInt32 unAccumulatedRobots = 0;
-		for (UInt32 i = 0; i < vecGroupSizes.size(); ++i) {
-			unAccumulatedRobots += vecGroupSizes[i];
-			if (unRobotId < unAccumulatedRobots) {
-				unGroupIndex = i;
-				break;
-			}
+		// The finite state machine is stepped by the swarm engine, which then calls Actuate().
+		if (m_bExternalStepping) {
+			return;
 		}
 
-		// Second pass: extract only group-specific parameters (ending in _<groupIndex>)
-		std::ostringstream oss;
-		std::string groupSuffix = "_" + std::to_string(unGroupIndex);
-		for (size_t i = 0; i + 1 < tokens.size(); ++i) {
-			const std::string& key = tokens[i];
-			const std::string& value = tokens[i + 1];
-
-			// Skip general flags like --ngroups, --g0, etc.
-			if (key.find("--g") == 0 || key == "--ngroups") continue;
-
-			// Include if it ends with _<groupIndex>
-			if (key.size() > groupSuffix.size() &&
-				key.compare(key.size() - groupSuffix.size(), groupSuffix.size(), groupSuffix) == 0) {
-				oss << key << " " << value << " ";
-				++i; // Skip value
-			}
-		}
+		/*
+		 * 2. Execute step of FSM
+		 */
+		m_pcFiniteStateMachine->ControlStep();
 
-		return oss.str();
+		Actuate();
 	}
 
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeController::ControlStep() {
+	void AutoMoDeController::UpdateRobotState() {
 		/*
 		 * 1. Update RobotDAO
 		 */
@@ -192,12 +198,12 @@ namespace argos {
             const CCI_EPuckOmnidirectionalCameraSensor::SReadings& readings = m_pcCameraSensor->GetReadings();
             m_pcRobotState->SetCameraInput(readings);
         }
+	}
 
-		/*
-		 * 2. Execute step of FSM
-		 */
-		m_pcFiniteStateMachine->ControlStep();
+	/****************************************/
+	/****************************************/
 
+	void AutoMoDeController::Actuate() {
 		/*
 		 * 3. Update Actuators
 		 */
@@ -216,8 +222,11 @@ namespace argos {
 			m_pcRabSensor->ClearPackets();
 		}
 		m_unTimeStep++;
-
 	}
+
+	/****************************************/
+	/****************************************/
+
 	UInt32 AutoMoDeController::GetRobotNumericId() {
 		return atoi(GetId().substr(5, 6).c_str());
 	}
@@ -231,7 +240,10 @@ namespace argos {
 	/****************************************/
 
 	void AutoMoDeController::Reset() {
-		m_pcFiniteStateMachine->Reset();
+		// When served by AutoMoDeMain, the finite state machine may only be given after the reset.
+		if (m_pcFiniteStateMachine != NULL) {
+			m_pcFiniteStateMachine->Reset();
+		}
 		m_pcRobotState->Reset();
 		// Restart actuation.
 		InitializeActuation();
@@ -250,6 +262,20 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
+	AutoMoDeFiniteStateMachine* AutoMoDeController::GetFiniteStateMachine() {
+		return m_pcFiniteStateMachine;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeController::SetExternalStepping(bool b_external_stepping) {
+		m_bExternalStepping = b_external_stepping;
+	}
+
+	/****************************************/
+	/****************************************/
+
 	void AutoMoDeController::SetHistoryFlag(bool b_history_flag) {
 		if (b_history_flag) {
 			m_pcFiniteStateMachine->MaintainHistory();
@@ -19,7 +19,8 @@
 
 
 #include "./AutoMoDeFiniteStateMachine.h"
-#include "./AutoMoDeFsmBuilder.h"
+#include "./AutoMoDeFsmBinary.h"
+#include "./AutoMoDeFsmTemplates.h"
 
 #include <argos3/plugins/robots/e-puck/control_interface/ci_epuck_wheels_actuator.h>
 #include <argos3/plugins/robots/e-puck/control_interface/ci_epuck_range_and_bearing_sensor.h>
@@ -68,11 +69,25 @@ namespace argos{
 			 */
 			void SetFiniteStateMachine(AutoMoDeFiniteStateMachine* pc_fine_state_machine);
 
+			/*
+			 * Getter for the AutoMoDeFiniteStateMachine.
+			 */
+			AutoMoDeFiniteStateMachine* GetFiniteStateMachine();
+
+			/*
+			 * When set, ControlStep() only updates the robot state: the finite state machine
+			 * is stepped, and Actuate() called, by an AutoMoDeSwarmEngine.
+			 */
+			void SetExternalStepping(bool b_external_stepping);
+
+			/*
+			 * Writes the actuators from the robot state, and ends the time step.
+			 */
+			void Actuate();
+
 			void SetHistoryFlag(bool b_history_flag);
 
 			UInt32 GetRobotNumericId();
-			
-			std::string ExtractGroupFsmConfig(const std::string& strFullConfig, UInt32 unRobotId);
 
 
 		private:
@@ -83,6 +98,11 @@ namespace argos{
 			 */
 			void InitializeActuation();
 
+			/*
+			 * Copies the readings of the sensors into the robot state.
+			 */
+			void UpdateRobotState();
+
 			/*
 			 * Pointer to the finite state machine object that represents the behaviour
 			 * of the robot.
@@ -110,6 +130,14 @@ namespace argos{
 			 */
 			std::string m_strFsmConfiguration;
 
+			/*
+			 * Path to a compiled finite state machine file, and index of the configuration
+			 * to use in it.
+			 * @see AutoMoDeFsmBinary
+			 */
+			std::string m_strFsmBinary;
+			UInt32 m_unFsmIndex;
+
 			/*
 			 * Flag that tells whether an history is maintained or not.
 			 */
@@ -127,9 +155,10 @@ namespace argos{
 			std::string m_strHistoryFolder;
 
 			/*
-			 * Pointer to the object in charge of creating the AutoMoDeFiniteStateMachine.
+			 * Pointer to the finite state machine created from the configuration of the
+			 * experiment file, which the controller owns.
 			 */
-			AutoMoDeFsmBuilder* m_pcFsmBuilder;
+			AutoMoDeFiniteStateMachine* m_pcConfiguredFiniteStateMachine;
 
 			/*
 			 * Pointer to the robot wheels actuator.
@@ -172,6 +201,11 @@ namespace argos{
 			CCI_EPuckOmnidirectionalCameraSensor* m_pcCameraSensor;
 
 			bool m_bFiniteStateMachineGiven;
+
+			/*
+			 * Whether the finite state machine is stepped by an AutoMoDeSwarmEngine.
+			 */
+			bool m_bExternalStepping;
 	};
 }
 
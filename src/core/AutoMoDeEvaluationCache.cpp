@@ -0,0 +1,207 @@
+/*
+ * @file <src/core/AutoMoDeEvaluationCache.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeEvaluationCache.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace argos {
+
+	static const char CACHE_MAGIC[8] = {'A', 'M', 'D', 'C', 'A', 'C', 'H', 'E'};
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeEvaluationCache::AutoMoDeEvaluationCache(const std::string& str_path, UInt32 un_capacity) :
+		m_strPath(str_path),
+		m_nFileDescriptor(-1),
+		m_unMappedSize(0),
+		m_psHeader(NULL),
+		m_psSlots(NULL),
+		m_unLookups(0),
+		m_unHits(0) {
+		// The capacity is rounded up to a power of two, so that slots are found with a mask.
+		UInt32 unCapacity = 1;
+		while (unCapacity < un_capacity && unCapacity < (1u << 31)) {
+			unCapacity <<= 1;
+		}
+
+		m_nFileDescriptor = open(str_path.c_str(), O_RDWR | O_CREAT, 0644);
+		if (m_nFileDescriptor < 0) {
+			THROW_ARGOSEXCEPTION("Error opening the cache file \"" << str_path << "\"");
+		}
+
+		Lock();
+		struct stat sStat;
+		SHeader sHeader;
+		bool bValid = (fstat(m_nFileDescriptor, &sStat) == 0);
+		if (bValid && sStat.st_size == 0) {
+			// New file: write the header, the slots being zero-filled by ftruncate.
+			memset(&sHeader, 0, sizeof(sHeader));
+			memcpy(sHeader.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+			sHeader.Version = VERSION;
+			sHeader.Capacity = unCapacity;
+			bValid = (ftruncate(m_nFileDescriptor, sizeof(SHeader) + (off_t) unCapacity * sizeof(SSlot)) == 0)
+				&& (pwrite(m_nFileDescriptor, &sHeader, sizeof(sHeader), 0) == sizeof(sHeader));
+		} else if (bValid) {
+			bValid = (pread(m_nFileDescriptor, &sHeader, sizeof(sHeader), 0) == sizeof(sHeader))
+				&& memcmp(sHeader.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0
+				&& sHeader.Version == VERSION
+				&& sHeader.Capacity > 0 && (sHeader.Capacity & (sHeader.Capacity - 1)) == 0
+				&& (size_t) sStat.st_size == sizeof(SHeader) + (size_t) sHeader.Capacity * sizeof(SSlot);
+		}
+		Unlock();
+		if (!bValid) {
+			close(m_nFileDescriptor);
+			THROW_ARGOSEXCEPTION("The file \"" << str_path << "\" is not a valid cache file");
+		}
+
+		m_unMappedSize = sizeof(SHeader) + (size_t) sHeader.Capacity * sizeof(SSlot);
+		void* ptMapping = mmap(NULL, m_unMappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_nFileDescriptor, 0);
+		if (ptMapping == MAP_FAILED) {
+			close(m_nFileDescriptor);
+			THROW_ARGOSEXCEPTION("Error mapping the cache file \"" << str_path << "\"");
+		}
+		m_psHeader = (SHeader*) ptMapping;
+		m_psSlots = (SSlot*) ((char*) ptMapping + sizeof(SHeader));
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeEvaluationCache::~AutoMoDeEvaluationCache() {
+		if (m_psHeader != NULL) {
+			munmap(m_psHeader, m_unMappedSize);
+		}
+		if (m_nFileDescriptor >= 0) {
+			close(m_nFileDescriptor);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeEvaluationCache::Lookup(const SAutoMoDeDigest& s_key, Real& f_score, bool& b_capped) {
+		bool bFound = false;
+		Lock();
+		SSlot* psSlot = FindSlot(s_key);
+		if (psSlot != NULL && (psSlot->Flags & FLAG_OCCUPIED)) {
+			f_score = psSlot->Score;
+			b_capped = (psSlot->Flags & FLAG_CAPPED) != 0;
+			bFound = true;
+			m_psHeader->Hits++;
+		}
+		m_psHeader->Lookups++;
+		Unlock();
+
+		m_unLookups++;
+		if (bFound) {
+			m_unHits++;
+		}
+		return bFound;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeEvaluationCache::Insert(const SAutoMoDeDigest& s_key, Real f_score, bool b_capped) {
+		Lock();
+		SSlot* psSlot = FindSlot(s_key);
+		if (psSlot != NULL) {
+			// A capped result never replaces a complete one.
+			bool bComplete = (psSlot->Flags & FLAG_OCCUPIED) && !(psSlot->Flags & FLAG_CAPPED);
+			if (!bComplete) {
+				if (!(psSlot->Flags & FLAG_OCCUPIED)) {
+					m_psHeader->Entries++;
+				}
+				psSlot->KeyHigh = s_key.High;
+				psSlot->KeyLow = s_key.Low;
+				psSlot->Score = f_score;
+				psSlot->Flags = FLAG_OCCUPIED | (b_capped ? FLAG_CAPPED : 0);
+			}
+		}
+		Unlock();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeEvaluationCache::CountHit() {
+		m_unLookups++;
+		m_unHits++;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	std::string AutoMoDeEvaluationCache::GetStatistics() {
+		Lock();
+		UInt64 unEntries = m_psHeader->Entries;
+		UInt64 unTotalLookups = m_psHeader->Lookups;
+		UInt64 unTotalHits = m_psHeader->Hits;
+		UInt32 unCapacity = m_psHeader->Capacity;
+		Unlock();
+
+		std::ostringstream oss;
+		oss << "Cache lookups " << m_unLookups
+			<< " hits " << m_unHits
+			<< " hit-rate " << (m_unLookups > 0 ? (Real) m_unHits / m_unLookups : 0)
+			<< " file-lookups " << unTotalLookups
+			<< " file-hits " << unTotalHits
+			<< " entries " << unEntries << "/" << unCapacity;
+		return oss.str();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeEvaluationCache::SSlot* AutoMoDeEvaluationCache::FindSlot(const SAutoMoDeDigest& s_key) {
+		UInt32 unMask = m_psHeader->Capacity - 1;
+		UInt32 unIndex = s_key.Low & unMask;
+		// Linear probing: the slots are never emptied, so the first empty slot ends the search.
+		for (UInt32 i = 0; i <= unMask; ++i) {
+			SSlot* psSlot = &m_psSlots[(unIndex + i) & unMask];
+			if (!(psSlot->Flags & FLAG_OCCUPIED)) {
+				return psSlot;
+			}
+			if (psSlot->KeyHigh == s_key.High && psSlot->KeyLow == s_key.Low) {
+				return psSlot;
+			}
+		}
+		return NULL;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeEvaluationCache::Lock() {
+		// Record locks belong to the process, so that forked processes exclude each other too.
+		struct flock sLock;
+		memset(&sLock, 0, sizeof(sLock));
+		sLock.l_type = F_WRLCK;
+		sLock.l_whence = SEEK_SET;
+		while (fcntl(m_nFileDescriptor, F_SETLKW, &sLock) != 0 && errno == EINTR) {}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeEvaluationCache::Unlock() {
+		struct flock sLock;
+		memset(&sLock, 0, sizeof(sLock));
+		sLock.l_type = F_UNLCK;
+		sLock.l_whence = SEEK_SET;
+		fcntl(m_nFileDescriptor, F_SETLK, &sLock);
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * @file <src/core/AutoMoDeEvaluationCache.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class stores the results of evaluations in a file, so that an
+ * 				evaluation that was already carried out, by this process or by
+ * 				any other one sharing the file, does not have to be simulated again.
+ * 				The file is a fixed-size hash table mapped in memory. Concurrent
+ * 				accesses are serialized with an advisory lock on the file.
+ */
+
+#ifndef AUTOMODE_EVALUATION_CACHE_H
+#define AUTOMODE_EVALUATION_CACHE_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+
+#include "AutoMoDeHash.h"
+
+#include <string>
+
+namespace argos {
+	class AutoMoDeEvaluationCache {
+		public:
+			/*
+			 * Opens the cache file str_path, creating it with un_capacity slots if it
+			 * does not exist yet. The capacity of an existing file is kept.
+			 */
+			AutoMoDeEvaluationCache(const std::string& str_path, UInt32 un_capacity);
+
+			/*
+			 * Class destructor.
+			 */
+			virtual ~AutoMoDeEvaluationCache();
+
+			/*
+			 * Looks the key up. Returns true, and sets f_score and b_capped to the stored
+			 * result, if the key is in the cache.
+			 */
+			bool Lookup(const SAutoMoDeDigest& s_key, Real& f_score, bool& b_capped);
+
+			/*
+			 * Stores the result of the evaluation identified by the key. Nothing is
+			 * stored if the cache is full.
+			 */
+			void Insert(const SAutoMoDeDigest& s_key, Real f_score, bool b_capped);
+
+			/*
+			 * Counts a lookup that was answered without reaching the file
+			 * (e.g. a duplicate within a batch).
+			 */
+			void CountHit();
+
+			/*
+			 * Returns a one-line summary of the statistics of this process and of the
+			 * statistics accumulated in the file by all the processes using it.
+			 */
+			std::string GetStatistics();
+
+		private:
+			/*
+			 * Header of the cache file.
+			 */
+			struct SHeader {
+				char Magic[8];
+				UInt32 Version;
+				UInt32 Capacity;
+				UInt64 Entries;
+				UInt64 Lookups;
+				UInt64 Hits;
+			};
+
+			/*
+			 * Slot of the hash table.
+			 */
+			struct SSlot {
+				UInt64 KeyHigh;
+				UInt64 KeyLow;
+				Real Score;
+				UInt32 Flags;
+				UInt32 Padding;
+			};
+
+			/*
+			 * Returns the slot holding the key, or the empty slot where it should be
+			 * stored, or NULL if the key is absent and the table is full.
+			 */
+			SSlot* FindSlot(const SAutoMoDeDigest& s_key);
+
+			void Lock();
+			void Unlock();
+
+			static const UInt32 VERSION = 1;
+			static const UInt32 FLAG_OCCUPIED = 1;
+			static const UInt32 FLAG_CAPPED = 2;
+
+			std::string m_strPath;
+			int m_nFileDescriptor;
+			size_t m_unMappedSize;
+			SHeader* m_psHeader;
+			SSlot* m_psSlots;
+
+			UInt64 m_unLookups;
+			UInt64 m_unHits;
+	};
+}
+
+#endif
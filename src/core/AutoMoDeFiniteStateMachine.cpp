@@ -10,30 +10,189 @@
 
 #include "AutoMoDeFiniteStateMachine.h"
 
+#include <new>
+
 namespace argos {
 
+	const UInt32 AutoMoDeFiniteStateMachine::MAX_OUTGOING_TRANSITIONS;
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Calls t_visitor with the behaviour cast to its actual type, if it is one of the
+	 * behaviours of this library, so that its methods are called without going through
+	 * the virtual table. Other behaviours are visited through the base class.
+	 */
+	template <class T> static void VisitBehaviour(AutoMoDeBehaviour* pc_behaviour, T& t_visitor) {
+		switch (pc_behaviour->GetType()) {
+			case AutoMoDeBehaviour::BEHAVIOUR_EXPLORATION:
+				t_visitor(static_cast<AutoMoDeBehaviourExploration*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_STOP:
+				t_visitor(static_cast<AutoMoDeBehaviourStop*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_PHOTOTAXIS:
+				t_visitor(static_cast<AutoMoDeBehaviourPhototaxis*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_ANTI_PHOTOTAXIS:
+				t_visitor(static_cast<AutoMoDeBehaviourAntiPhototaxis*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_ATTRACTION:
+				t_visitor(static_cast<AutoMoDeBehaviourAttraction*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_REPULSION:
+				t_visitor(static_cast<AutoMoDeBehaviourRepulsion*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_GO_TO_COLOR:
+				t_visitor(static_cast<AutoMoDeBehaviourGoToColor*>(pc_behaviour));
+				break;
+			case AutoMoDeBehaviour::BEHAVIOUR_GO_AWAY_COLOR:
+				t_visitor(static_cast<AutoMoDeBehaviourGoAwayColor*>(pc_behaviour));
+				break;
+			default:
+				t_visitor(pc_behaviour);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Same as VisitBehaviour(), for conditions.
+	 */
+	template <class T> static void VisitCondition(AutoMoDeCondition* pc_condition, T& t_visitor) {
+		switch (pc_condition->GetType()) {
+			case AutoMoDeCondition::CONDITION_BLACK_FLOOR:
+				t_visitor(static_cast<AutoMoDeConditionBlackFloor*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_GRAY_FLOOR:
+				t_visitor(static_cast<AutoMoDeConditionGrayFloor*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_WHITE_FLOOR:
+				t_visitor(static_cast<AutoMoDeConditionWhiteFloor*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_NEIGHBORS_COUNT:
+				t_visitor(static_cast<AutoMoDeConditionNeighborsCount*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_INVERTED_NEIGHBORS_COUNT:
+				t_visitor(static_cast<AutoMoDeConditionInvertedNeighborsCount*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_FIXED_PROBABILITY:
+				t_visitor(static_cast<AutoMoDeConditionFixedProbability*>(pc_condition));
+				break;
+			case AutoMoDeCondition::CONDITION_PROB_COLOR:
+				t_visitor(static_cast<AutoMoDeConditionProbColor*>(pc_condition));
+				break;
+			default:
+				t_visitor(pc_condition);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Visitors calling one method of a module. The qualified calls T::Method() are not
+	 * virtual; the overloads taking the base class handle the modules defined elsewhere.
+	 */
+	struct SBehaviourControlStep {
+		template <class T> void operator()(T* pc_behaviour) { pc_behaviour->T::ControlStep(); }
+		void operator()(AutoMoDeBehaviour* pc_behaviour) { pc_behaviour->ControlStep(); }
+	};
+
+	struct SBehaviourResumeStep {
+		template <class T> void operator()(T* pc_behaviour) { pc_behaviour->T::ResumeStep(); }
+		void operator()(AutoMoDeBehaviour* pc_behaviour) { pc_behaviour->ResumeStep(); }
+	};
+
+	struct SBehaviourReset {
+		template <class T> void operator()(T* pc_behaviour) { pc_behaviour->T::Reset(); }
+		void operator()(AutoMoDeBehaviour* pc_behaviour) { pc_behaviour->Reset(); }
+	};
+
+	struct SConditionVerify {
+		EpuckDAO* RobotDAO;
+		AutoMoDeRandomStream* RandomStream;
+		bool Result;
+		template <class T> void operator()(T* pc_condition) { Result = pc_condition->T::Verify(RobotDAO, RandomStream); }
+		void operator()(AutoMoDeCondition* pc_condition) { Result = pc_condition->Verify(); }
+	};
+
+	struct SConditionReset {
+		template <class T> void operator()(T* pc_condition) { pc_condition->T::Reset(); }
+		void operator()(AutoMoDeCondition* pc_condition) { pc_condition->Reset(); }
+	};
+
+	/*
+	 * Visitors copying a module into an arena. The modules defined elsewhere are cloned
+	 * on the heap, as they can only be copied through Clone().
+	 */
+	struct SBehaviourClone {
+		AutoMoDeArena* Arena;
+		AutoMoDeBehaviour* Result;
+		template <class T> void operator()(T* pc_behaviour) { Result = new (Arena->Allocate(sizeof(T))) T(pc_behaviour); }
+		void operator()(AutoMoDeBehaviour* pc_behaviour) { Result = pc_behaviour->Clone(); }
+	};
+
+	struct SConditionClone {
+		AutoMoDeArena* Arena;
+		AutoMoDeCondition* Result;
+		template <class T> void operator()(T* pc_condition) { Result = new (Arena->Allocate(sizeof(T))) T(pc_condition); }
+		void operator()(AutoMoDeCondition* pc_condition) { Result = pc_condition->Clone(); }
+	};
+
+	/*
+	 * Visitor copying a behaviour of a definition into the storage of an instance.
+	 */
+	struct SBehaviourCopy {
+		void* Storage;
+		AutoMoDeBehaviour* Result;
+		template <class T> void operator()(T* pc_behaviour) { Result = new (Storage) T(*pc_behaviour); }
+		void operator()(AutoMoDeBehaviour* pc_behaviour) {
+			THROW_ARGOSEXCEPTION("The behaviour " << pc_behaviour->GetLabel() << " cannot be shared.");
+		}
+	};
+
 	/****************************************/
 	/****************************************/
 
 	AutoMoDeFiniteStateMachine::AutoMoDeFiniteStateMachine() {
-		m_unCurrentBehaviourIndex = 0;
-		m_bEnteringNewState = true;
+		m_psStepState = &m_sOwnStepState;
+		m_pcArena = NULL;
+		m_pcDefinition = NULL;
+		m_pcCurrentBehaviour = NULL;
+		m_psStepState->FirstCurrentTransition = 0;
+		m_psStepState->NumberCurrentTransitions = 0;
+		m_psStepState->CurrentBehaviourIndex = 0;
+		m_psStepState->EnteringNewState = true;
 		m_bMaintainHistory = false;
-		m_unTimeStep = 0;
+		m_psStepState->TimeStep = 0;
 	}
 
 	/****************************************/
 	/****************************************/
 
 	AutoMoDeFiniteStateMachine::~AutoMoDeFiniteStateMachine() {
+		// The modules placed in an arena are destroyed, their memory being released with the arena.
 		for (unsigned int i = 0; i < m_vecBehaviours.size(); ++i) {
-			delete m_vecBehaviours.at(i);
+			if (m_pcArena != NULL && m_vecBehaviours.at(i)->GetType() != AutoMoDeBehaviour::BEHAVIOUR_EXTERNAL) {
+				m_vecBehaviours.at(i)->~AutoMoDeBehaviour();
+			} else {
+				delete m_vecBehaviours.at(i);
+			}
 		}
 
 		for (unsigned int i = 0; i < m_vecConditions.size(); ++i) {
-			delete m_vecConditions.at(i);
+			if (m_pcArena != NULL && m_vecConditions.at(i)->GetType() != AutoMoDeCondition::CONDITION_EXTERNAL) {
+				m_vecConditions.at(i)->~AutoMoDeCondition();
+			} else {
+				delete m_vecConditions.at(i);
+			}
 		}
 
+		ReleaseBehaviour();
+
 		if (m_bMaintainHistory) {
 			delete m_pcHistory;
 		}
@@ -44,22 +203,100 @@ namespace argos {
 	/****************************************/
 
 	AutoMoDeFiniteStateMachine::AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_fsm) {
-		m_unCurrentBehaviourIndex = pc_fsm->GetCurrentBehaviourIndex();
-		m_bEnteringNewState = pc_fsm->GetEnteringNewStateFlag();
+		CopyFrom(pc_fsm, NULL);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFiniteStateMachine::AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_fsm, AutoMoDeArena& c_arena) {
+		CopyFrom(pc_fsm, &c_arena);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFiniteStateMachine::AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_definition, EInstance) {
+		if (!pc_definition->IsShareable()) {
+			THROW_ARGOSEXCEPTION("Could not create an instance of a finite state machine that cannot be shared.");
+		}
+		m_psStepState = &m_sOwnStepState;
+		m_pcArena = NULL;
+		m_pcDefinition = pc_definition;
+		m_pcCurrentBehaviour = NULL;
+		m_psStepState->FirstCurrentTransition = 0;
+		m_psStepState->NumberCurrentTransitions = 0;
+		m_psStepState->CurrentBehaviourIndex = pc_definition->GetCurrentBehaviourIndex();
+		m_psStepState->EnteringNewState = pc_definition->GetEnteringNewStateFlag();
+		m_bMaintainHistory = pc_definition->GetMaintainHistoryFlag();
+		m_psStepState->TimeStep = pc_definition->GetTimeStep();
+
+		if (m_bMaintainHistory) {
+			m_pcHistory = new AutoMoDeFsmHistory(pc_definition->GetHistory());
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeFiniteStateMachine::IsShareable() const {
+		if (m_pcDefinition != NULL || m_vecTransitionOffsets.size() != m_vecBehaviours.size() + 1) {
+			return false;
+		}
+		for (UInt32 i = 0; i < m_vecBehaviours.size(); ++i) {
+			if (m_vecBehaviours.at(i)->GetType() == AutoMoDeBehaviour::BEHAVIOUR_EXTERNAL) {
+				return false;
+			}
+		}
+		for (UInt32 i = 0; i < m_vecConditions.size(); ++i) {
+			if (m_vecConditions.at(i)->GetType() == AutoMoDeCondition::CONDITION_EXTERNAL) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::CopyFrom(const AutoMoDeFiniteStateMachine* pc_fsm, AutoMoDeArena* pc_arena) {
+		m_psStepState = &m_sOwnStepState;
+		m_pcArena = pc_arena;
+		m_pcDefinition = NULL;
+		m_psStepState->FirstCurrentTransition = 0;
+		m_psStepState->NumberCurrentTransitions = 0;
+		m_psStepState->CurrentBehaviourIndex = pc_fsm->GetCurrentBehaviourIndex();
+		m_psStepState->EnteringNewState = pc_fsm->GetEnteringNewStateFlag();
 		m_bMaintainHistory = pc_fsm->GetMaintainHistoryFlag();
-		m_unTimeStep = pc_fsm->GetTimeStep();
+		m_psStepState->TimeStep = pc_fsm->GetTimeStep();
 
 		std::vector<AutoMoDeBehaviour*> vecBehaviours = pc_fsm->GetBehaviours();
 		m_vecBehaviours.clear();
+		m_vecBehaviours.reserve(vecBehaviours.size());
 		for (std::vector<AutoMoDeBehaviour*>::iterator it = vecBehaviours.begin(); it != vecBehaviours.end(); ++it) {
-			m_vecBehaviours.push_back((*it)->Clone());
+			if (m_pcArena == NULL) {
+				m_vecBehaviours.push_back((*it)->Clone());
+			} else {
+				SBehaviourClone sClone;
+				sClone.Arena = m_pcArena;
+				VisitBehaviour(*it, sClone);
+				m_vecBehaviours.push_back(sClone.Result);
+			}
 		}
-		m_pcCurrentBehaviour = m_vecBehaviours.at(m_unCurrentBehaviourIndex);
+		m_pcCurrentBehaviour = m_vecBehaviours.at(m_psStepState->CurrentBehaviourIndex);
 
 		std::vector<AutoMoDeCondition*> vecConditions = pc_fsm->GetConditions();
 		m_vecConditions.clear();
+		m_vecConditions.reserve(vecConditions.size());
 		for (std::vector<AutoMoDeCondition*>::iterator it = vecConditions.begin(); it != vecConditions.end(); ++it) {
-			m_vecConditions.push_back((*it)->Clone());
+			if (m_pcArena == NULL) {
+				m_vecConditions.push_back((*it)->Clone());
+			} else {
+				SConditionClone sClone;
+				sClone.Arena = m_pcArena;
+				VisitCondition(*it, sClone);
+				m_vecConditions.push_back(sClone.Result);
+			}
 		}
 
 		if (m_bMaintainHistory) {
@@ -72,42 +309,64 @@ namespace argos {
 
 	void AutoMoDeFiniteStateMachine::ControlStep(){
 		//LOG << m_pcCurrentBehaviour->GetLabel() << std::endl;
+		SStepState& sState = *m_psStepState;
 		/*
 		 * 1. Dealing with behaviours
 		 */
-		if (m_bEnteringNewState) {
-			m_pcCurrentBehaviour->Reset();
+		if (m_pcCurrentBehaviour == NULL) {
+			// Instance that was reset.
+			LoadBehaviour(sState.CurrentBehaviourIndex);
+		}
+		sState.RandomStream.SetTick(sState.TimeStep);
+
+		if (sState.EnteringNewState) {
+			SBehaviourReset sReset;
+			VisitBehaviour(m_pcCurrentBehaviour, sReset);
 		}
 
 		if (m_pcCurrentBehaviour->IsOperational()) {
-			m_pcCurrentBehaviour->ControlStep();
+			SBehaviourControlStep sControlStep;
+			VisitBehaviour(m_pcCurrentBehaviour, sControlStep);
 		} else {
-			m_pcCurrentBehaviour->ResumeStep();
+			SBehaviourResumeStep sResumeStep;
+			VisitBehaviour(m_pcCurrentBehaviour, sResumeStep);
 		}
 
 		/*
 		 * 2. Dealing with conditions
 		 */
-		m_mapConditionsChecked.clear();
+		// Bit sets of the transitions whose condition was checked, and fulfilled, by position.
+		UInt32 unConditionsChecked = 0;
+		UInt32 unConditionsFulfilled = 0;
+		std::vector<STransition>::const_iterator itCurrentTransitions = GetTransitionTableHolder()->m_vecTransitions.begin() + sState.FirstCurrentTransition;
 		if (!m_pcCurrentBehaviour->IsLocked()) {
-			if (m_bEnteringNewState) {
-				m_vecCurrentConditions = GetOutgoingConditions();
-				m_bEnteringNewState = false;
+			if (sState.EnteringNewState) {
+				LoadOutgoingTransitions();
+				sState.EnteringNewState = false;
 			}
 			else {
-				std::random_shuffle(m_vecCurrentConditions.begin(), m_vecCurrentConditions.end());
-				for (std::vector<AutoMoDeCondition*>::iterator it = m_vecCurrentConditions.begin(); it != m_vecCurrentConditions.end(); it++) {
+				ShuffleTransitionOrder();
+				for (UInt32 i = 0; i < sState.NumberCurrentTransitions; ++i) {
 					/*
 					 * 3. Update current behaviour
 					 */
-					if ((*it)->Verify()) {
-						m_mapConditionsChecked.insert(std::pair<AutoMoDeCondition*, bool>((*it), true));
-						m_unCurrentBehaviourIndex = (*it)->GetExtremity();
-						m_pcCurrentBehaviour = m_vecBehaviours.at(m_unCurrentBehaviourIndex);
-						m_bEnteringNewState = true;
+					UInt32 unPosition = sState.TransitionOrder[i];
+					const STransition& sTransition = itCurrentTransitions[unPosition];
+					SConditionVerify sVerify;
+					sVerify.RobotDAO = m_pcRobotDAO;
+					sVerify.RandomStream = &sState.RandomStream;
+					VisitCondition(sTransition.Condition, sVerify);
+					unConditionsChecked |= (1u << unPosition);
+					if (sVerify.Result) {
+						unConditionsFulfilled |= (1u << unPosition);
+						sState.CurrentBehaviourIndex = sTransition.Destination;
+						if (m_pcDefinition == NULL) {
+							m_pcCurrentBehaviour = m_vecBehaviours.at(sState.CurrentBehaviourIndex);
+						} else {
+							LoadBehaviour(sState.CurrentBehaviourIndex);
+						}
+						sState.EnteringNewState = true;
 						break;
-					} else {
-						m_mapConditionsChecked.insert(std::pair<AutoMoDeCondition*, bool>((*it), false));
 					}
 				}
 			}
@@ -117,57 +376,161 @@ namespace argos {
 		 * 4. Dealing with history
 		 */
 		if (m_bMaintainHistory) {
-			m_pcHistory->AddTimeStep(m_unTimeStep, m_pcCurrentBehaviour, m_mapConditionsChecked);
+			AutoMoDeFsmHistory::SCheckedCondition sCheckedConditions[MAX_OUTGOING_TRANSITIONS];
+			UInt32 unNumberCheckedConditions = 0;
+			for (UInt32 i = 0; i < sState.NumberCurrentTransitions; ++i) {
+				if (unConditionsChecked & (1u << i)) {
+					sCheckedConditions[unNumberCheckedConditions].Condition = itCurrentTransitions[i].Condition;
+					sCheckedConditions[unNumberCheckedConditions].Fulfilled = ((unConditionsFulfilled & (1u << i)) != 0);
+					++unNumberCheckedConditions;
+				}
+			}
+			m_pcHistory->AddTimeStep(sState.TimeStep, m_pcCurrentBehaviour, sCheckedConditions, unNumberCheckedConditions);
 		}
 
 		/*
 		 * 5. Dealing with variables
 		 */
-		m_unTimeStep += 1;
+		sState.TimeStep += 1;
 	}
 
 	/****************************************/
 	/****************************************/
 
 	void AutoMoDeFiniteStateMachine::Init() {
-		ShareRobotDAO();
-		m_pcCurrentBehaviour = m_vecBehaviours.at(m_unCurrentBehaviourIndex);
+		KeyRandomStream();
+		if (m_pcDefinition == NULL) {
+			ShareRobotDAO();
+			CompileTransitionTable();
+			m_pcCurrentBehaviour = m_vecBehaviours.at(m_psStepState->CurrentBehaviourIndex);
+		} else {
+			LoadBehaviour(m_psStepState->CurrentBehaviourIndex);
+		}
 	}
 
 	/****************************************/
 	/****************************************/
 
 	void AutoMoDeFiniteStateMachine::Reset() {
-		m_unTimeStep = 0;
-		m_bEnteringNewState = true;
-		m_unCurrentBehaviourIndex = 0;
-		m_pcCurrentBehaviour = m_vecBehaviours.at(m_unCurrentBehaviourIndex);
+		m_psStepState->TimeStep = 0;
+		m_psStepState->EnteringNewState = true;
+		m_psStepState->CurrentBehaviourIndex = 0;
+		m_psStepState->FirstCurrentTransition = 0;
+		m_psStepState->NumberCurrentTransitions = 0;
+		// The seed may have changed.
+		KeyRandomStream();
+		if (m_pcDefinition != NULL) {
+			// The definition may already be destroyed: the behaviour is loaded by the next ControlStep().
+			ReleaseBehaviour();
+			return;
+		}
+		m_pcCurrentBehaviour = m_vecBehaviours.at(m_psStepState->CurrentBehaviourIndex);
+		SConditionReset sConditionReset;
 		std::vector<AutoMoDeCondition*>::iterator itC;
 		for (itC = m_vecConditions.begin(); itC != m_vecConditions.end(); ++itC) {
-			(*itC)->Reset();
+			VisitCondition(*itC, sConditionReset);
 		}
+		SBehaviourReset sBehaviourReset;
 		std::vector<AutoMoDeBehaviour*>::iterator itB;
 		for (itB = m_vecBehaviours.begin(); itB != m_vecBehaviours.end(); ++itB) {
-			(*itB)->Reset();
+			VisitBehaviour(*itB, sBehaviourReset);
 		}
 	}
 
 	/****************************************/
 	/****************************************/
 
-	std::vector<AutoMoDeCondition*> AutoMoDeFiniteStateMachine::GetOutgoingConditions() {
+	void AutoMoDeFiniteStateMachine::CompileTransitionTable() {
+		UInt32 unNumberStates = m_vecBehaviours.size();
 		std::vector<AutoMoDeCondition*>::iterator it;
-		std::vector<AutoMoDeCondition*> vecResult;
-		UInt8 unConditionOrigin;
 
+		// Count the transitions of each state, then turn the counts into offsets.
+		m_vecTransitionOffsets.assign(unNumberStates + 1, 0);
 		for (it = m_vecConditions.begin(); it != m_vecConditions.end(); ++it) {
-			unConditionOrigin = (*it)->GetOrigin();
-			if (unConditionOrigin == m_unCurrentBehaviourIndex) {
-				vecResult.push_back(*it);
+			if ((*it)->GetOrigin() < unNumberStates) {
+				m_vecTransitionOffsets[(*it)->GetOrigin() + 1] += 1;
+			}
+		}
+		for (UInt32 i = 0; i < unNumberStates; ++i) {
+			if (m_vecTransitionOffsets[i + 1] > MAX_OUTGOING_TRANSITIONS) {
+				m_vecTransitionOffsets.clear();
+				THROW_ARGOSEXCEPTION("State " << i << " has more than " << MAX_OUTGOING_TRANSITIONS << " transitions");
 			}
+			m_vecTransitionOffsets[i + 1] += m_vecTransitionOffsets[i];
+		}
+
+		// File the transitions, keeping the order in which the conditions were added.
+		m_vecTransitions.resize(m_vecTransitionOffsets[unNumberStates]);
+		std::vector<UInt32> vecNextSlot(m_vecTransitionOffsets.begin(), m_vecTransitionOffsets.end() - 1);
+		for (it = m_vecConditions.begin(); it != m_vecConditions.end(); ++it) {
+			if ((*it)->GetOrigin() < unNumberStates) {
+				STransition& sTransition = m_vecTransitions[vecNextSlot[(*it)->GetOrigin()]++];
+				sTransition.Condition = *it;
+				sTransition.Destination = (*it)->GetExtremity();
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::LoadBehaviour(UInt32 un_index) {
+		ReleaseBehaviour();
+		SBehaviourCopy sCopy;
+		sCopy.Storage = &m_uBehaviourStorage;
+		VisitBehaviour(m_pcDefinition->m_vecBehaviours.at(un_index), sCopy);
+		m_pcCurrentBehaviour = sCopy.Result;
+		m_pcCurrentBehaviour->SetRobotDAO(m_pcRobotDAO);
+		m_pcCurrentBehaviour->SetRandomStream(&m_psStepState->RandomStream);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::ReleaseBehaviour() {
+		if (m_pcDefinition != NULL && m_pcCurrentBehaviour != NULL) {
+			m_pcCurrentBehaviour->~AutoMoDeBehaviour();
+			m_pcCurrentBehaviour = NULL;
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const AutoMoDeFiniteStateMachine* AutoMoDeFiniteStateMachine::GetTransitionTableHolder() const {
+		// An instance reads the transition table of its definition.
+		return (m_pcDefinition != NULL) ? m_pcDefinition : this;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::LoadOutgoingTransitions() {
+		const std::vector<UInt32>& vecOffsets = GetTransitionTableHolder()->m_vecTransitionOffsets;
+		m_psStepState->FirstCurrentTransition = vecOffsets[m_psStepState->CurrentBehaviourIndex];
+		m_psStepState->NumberCurrentTransitions = vecOffsets[m_psStepState->CurrentBehaviourIndex + 1] - m_psStepState->FirstCurrentTransition;
+		for (UInt32 i = 0; i < m_psStepState->NumberCurrentTransitions; ++i) {
+			m_psStepState->TransitionOrder[i] = i;
 		}
+	}
 
-		return vecResult;
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::ShuffleTransitionOrder() {
+		// Fisher-Yates shuffle: std::random_shuffle would draw from the process-wide rand().
+		for (UInt32 i = m_psStepState->NumberCurrentTransitions; i > 1; --i) {
+			std::swap(m_psStepState->TransitionOrder[i - 1], m_psStepState->TransitionOrder[m_psStepState->RandomStream.Uniform(CRange<UInt32>(0, i))]);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::KeyRandomStream() {
+		// Outside of a simulation, there is no seed.
+		UInt32 unSeed = (CRandom::ExistsCategory("argos") ? CRandom::GetSeedOf("argos") : 0);
+		m_psStepState->RandomStream.SetKey(unSeed, m_pcRobotDAO->GetRobotIdentifier());
 	}
 
 	/****************************************/
@@ -223,8 +586,9 @@ namespace argos {
 	const std::string AutoMoDeFiniteStateMachine::FillWithInitialState() {
 		std::stringstream ssUrl;
 		ssUrl << "node [shape = doublecircle]; " ;
+		std::vector<AutoMoDeBehaviour*> vecBehaviours = GetBehaviours();
 		std::vector<AutoMoDeBehaviour*>::iterator it;
-		for (it = m_vecBehaviours.begin(); it != m_vecBehaviours.end(); it++) {
+		for (it = vecBehaviours.begin(); it != vecBehaviours.end(); it++) {
 			if ((*it)->GetIndex() == 0) {
 				ssUrl << "S0 [label=\"" << (*it)->GetDOTDescription() << "\"; color=blue];" ;
 				break;
@@ -239,14 +603,15 @@ namespace argos {
 	const std::string AutoMoDeFiniteStateMachine::FillWithNonInitialStates() {
 		std::stringstream ssUrl;
 		ssUrl << "node [shape = circle];" ;
+		std::vector<AutoMoDeBehaviour*> vecBehaviours = GetBehaviours();
 		std::vector<AutoMoDeBehaviour*>::iterator it;
-		for (it = m_vecBehaviours.begin(); it != m_vecBehaviours.end(); it++) {
+		for (it = vecBehaviours.begin(); it != vecBehaviours.end(); it++) {
 			if ((*it)->GetIndex() != 0) {
 				ssUrl << "S" << (*it)->GetIndex() << " [label=\"" << (*it)->GetDOTDescription() << "\"; color=blue]" ;
 			}
 		}
 		// If there is only one behaviour, do not add extra ";".
-		if (m_vecBehaviours.size() > 1) {
+		if (vecBehaviours.size() > 1) {
 			ssUrl << ";";
 		}
 		return ssUrl.str();
@@ -257,16 +622,17 @@ namespace argos {
 
 	const std::string AutoMoDeFiniteStateMachine::FillWithConditions() {
 		std::stringstream ssUrl;
+		std::vector<AutoMoDeCondition*> vecConditions = GetConditions();
 		std::vector<AutoMoDeCondition*>::iterator it;
 
 		// Creation of conditions
 		ssUrl << "node [shape = diamond];" ;
-		for (it = m_vecConditions.begin(); it != m_vecConditions.end(); it++) {
+		for (it = vecConditions.begin(); it != vecConditions.end(); it++) {
 			ssUrl << "C" << (*it)->GetOrigin() << "x" << (*it)->GetIndex() << " [label=\"" << (*it)->GetDOTDescription() << "\"; color=green];" ;
 		}
 
 		// Creation of transitions between behaviours and conditions
-		for (it = m_vecConditions.begin(); it != m_vecConditions.end(); it++) {
+		for (it = vecConditions.begin(); it != vecConditions.end(); it++) {
 			ssUrl << "S" << (*it)->GetOrigin() << " -> C" << (*it)->GetOrigin() << "x" << (*it)->GetIndex() << ";" ;
 			ssUrl << "C" << (*it)->GetOrigin() << "x" << (*it)->GetIndex() << " -> S" << (*it)->GetExtremity() << ";" ;
 		}
@@ -278,7 +644,7 @@ namespace argos {
 	/****************************************/
 
 	const UInt32& AutoMoDeFiniteStateMachine::GetCurrentBehaviourIndex() const {
-		return m_unCurrentBehaviourIndex;
+		return m_psStepState->CurrentBehaviourIndex;
 	}
 
 	/****************************************/
@@ -292,28 +658,48 @@ namespace argos {
 	/****************************************/
 
 	const bool AutoMoDeFiniteStateMachine::GetEnteringNewStateFlag() const {
-		return m_bEnteringNewState;
+		return m_psStepState->EnteringNewState;
 	}
 
 	/****************************************/
 	/****************************************/
 
 	const UInt32& AutoMoDeFiniteStateMachine::GetTimeStep() const {
-		return m_unTimeStep;
+		return m_psStepState->TimeStep;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const AutoMoDeFiniteStateMachine::SStepState& AutoMoDeFiniteStateMachine::GetStepState() const {
+		return *m_psStepState;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::SetStepState(SStepState* ps_step_state) {
+		SStepState* psStepState = (ps_step_state == NULL) ? &m_sOwnStepState : ps_step_state;
+		if (psStepState != m_psStepState) {
+			*psStepState = *m_psStepState;
+			m_psStepState = psStepState;
+		}
+		// The modules draw from the random numbers of the robot, which moved.
+		ShareRandomStream();
 	}
 
 	/****************************************/
 	/****************************************/
 
 	std::vector<AutoMoDeBehaviour*> AutoMoDeFiniteStateMachine::GetBehaviours() const {
-		return m_vecBehaviours;
+		return (m_pcDefinition != NULL) ? m_pcDefinition->m_vecBehaviours : m_vecBehaviours;
 	}
 
 	/****************************************/
 	/****************************************/
 
 	std::vector<AutoMoDeCondition*> AutoMoDeFiniteStateMachine::GetConditions() const {
-		return m_vecConditions;
+		return (m_pcDefinition != NULL) ? m_pcDefinition->m_vecConditions : m_vecConditions;
 	}
 
 	/****************************************/
@@ -342,5 +728,28 @@ namespace argos {
 		for (itB = m_vecBehaviours.begin(); itB != m_vecBehaviours.end(); ++itB) {
 			(*itB)->SetRobotDAO(m_pcRobotDAO);
 		}
+		ShareRandomStream();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFiniteStateMachine::ShareRandomStream() {
+		AutoMoDeRandomStream* pcRandomStream = &m_psStepState->RandomStream;
+		if (m_pcDefinition != NULL) {
+			// The conditions of the definition are given the random numbers when verified.
+			if (m_pcCurrentBehaviour != NULL) {
+				m_pcCurrentBehaviour->SetRandomStream(pcRandomStream);
+			}
+			return;
+		}
+		std::vector<AutoMoDeCondition*>::iterator itC;
+		std::vector<AutoMoDeBehaviour*>::iterator itB;
+		for (itC = m_vecConditions.begin(); itC != m_vecConditions.end(); ++itC) {
+			(*itC)->SetRandomStream(pcRandomStream);
+		}
+		for (itB = m_vecBehaviours.begin(); itB != m_vecBehaviours.end(); ++itB) {
+			(*itB)->SetRandomStream(pcRandomStream);
+		}
 	}
 }
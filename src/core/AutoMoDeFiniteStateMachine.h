@@ -10,7 +10,8 @@
  * @brief	This class represents the stochastic Finite State
  * 				Machine (FSM) that controls the robot. It contains all the modules
  *       	(behaviours and conditions) and is responsible for the transitions
- * 				between them.
+ * 				between them. An instance of a FSM shares the modules of its
+ * 				definition and only holds the state of its robot.
  */
 
 #ifndef AUTOMODE_FINITE_STATE_MACHINE_H
@@ -18,6 +19,7 @@
 
 #include <argos3/demiurge/epuck-dao/EpuckDAO.h>
 
+#include "AutoMoDeArena.h"
 #include "AutoMoDeFsmHistory.h"
 #include "../modules/AutoMoDeBehaviour.h"
 #include "../modules/AutoMoDeBehaviourAttraction.h"
@@ -46,6 +48,59 @@ namespace argos {
 
 		public:
 
+			/*
+			 * Largest number of transitions going out of a state. The transitions of the
+			 * active state are followed with fixed-size buffers and bit sets, so that a
+			 * step of the FSM does not allocate memory.
+			 */
+			static const UInt32 MAX_OUTGOING_TRANSITIONS = 32;
+
+			/*
+			 * State of the robot that ControlStep() reads and writes at each step. It is held
+			 * by the FSM, unless moved elsewhere with SetStepState(): the swarm engine keeps
+			 * the states of the robots of a group in one array.
+			 * @see AutoMoDeSwarmEngine
+			 */
+			struct SStepState {
+				/*
+				 * The index of the behaviour corresponding to the current
+				 * active state of the FSM.
+				 */
+				UInt32 CurrentBehaviourIndex;
+
+				/*
+				 * The current time step.
+				 */
+				UInt32 TimeStep;
+
+				/*
+				 * The transitions going out of the active state: their position in the
+				 * transition table, and their number.
+				 * Their conditions will be checked and determine the next state of the FSM.
+				 */
+				UInt32 FirstCurrentTransition;
+				UInt32 NumberCurrentTransitions;
+
+				/*
+				 * Flag indicating if the FSM is changing state.
+				 */
+				bool EnteringNewState;
+
+				/*
+				 * Order in which the transitions going out of the active state are checked:
+				 * a permutation of their positions, shuffled in place at each step.
+				 * @see ShuffleTransitionOrder()
+				 */
+				UInt8 TransitionOrder[MAX_OUTGOING_TRANSITIONS];
+
+				/*
+				 * Random numbers of the robot, keyed by the seed of the experiment and the
+				 * identifier of the robot, and moved to the current time step at each step.
+				 * @see AutoMoDeRandomStream
+				 */
+				AutoMoDeRandomStream RandomStream;
+			};
+
 			/*
 			 * Class constructor.
 			 */
@@ -62,6 +117,42 @@ namespace argos {
 			 */
 			AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_fsm);
 
+			/*
+			 * Copy constructor placing the modules of this library in an arena.
+			 * Such a finite state machine must be destroyed before the arena is cleared.
+			 */
+			AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_fsm, AutoMoDeArena& c_arena);
+
+			/*
+			 * Tag of the constructor of instances.
+			 */
+			enum EInstance {
+				INSTANCE
+			};
+
+			/*
+			 * Creates an instance of pc_definition, which must be shareable. The instance
+			 * does not copy the modules: it reads the conditions and the transition table of
+			 * pc_definition, and copies the behaviour of a state into its own storage when
+			 * entering it. pc_definition must outlive the instance, except that the instance
+			 * may still be reset and destroyed once pc_definition is gone.
+			 * @see IsShareable()
+			 */
+			AutoMoDeFiniteStateMachine(const AutoMoDeFiniteStateMachine* pc_definition, EInstance);
+
+			/*
+			 * Returns whether instances of the FSM can be created: all its modules are part
+			 * of this library, and its transition table is compiled.
+			 */
+			bool IsShareable() const;
+
+			/*
+			 * Groups the conditions by the state they start from, in the transition table.
+			 * Throws if a state has more than MAX_OUTGOING_TRANSITIONS transitions.
+			 * Called by Init(), and by the builder so that the FSM it builds is shareable.
+			 */
+			void CompileTransitionTable();
+
 			/*
 			 * Add a condition to the FSM.
 			 */
@@ -114,12 +205,23 @@ namespace argos {
 			const UInt32& GetTimeStep() const;
 
 			/*
-			 * Returns all the behaviours contained in the FSM.
+			 * Returns the state of the robot read and written at each step.
+			 */
+			const SStepState& GetStepState() const;
+
+			/*
+			 * Moves the state of the robot read and written at each step to ps_step_state,
+			 * or back into the FSM if NULL. ps_step_state must outlive its use by the FSM.
+			 */
+			void SetStepState(SStepState* ps_step_state);
+
+			/*
+			 * Returns all the behaviours contained in the FSM, or in its definition.
 			 */
 			std::vector<AutoMoDeBehaviour*> GetBehaviours() const;
 
 			/*
-			 * Returns all the conditions contained in the FSM.
+			 * Returns all the conditions contained in the FSM, or in its definition.
 			 */
 			std::vector<AutoMoDeCondition*> GetConditions() const;
 
@@ -145,28 +247,69 @@ namespace argos {
 			 */
 			std::vector<AutoMoDeCondition*> m_vecConditions;
 
+			/*
+			 * Arena holding the modules of this library, or NULL if they are on the heap.
+			 */
+			AutoMoDeArena* m_pcArena;
+
+			/*
+			 * The FSM this one is an instance of, or NULL if it owns its modules.
+			 */
+			const AutoMoDeFiniteStateMachine* m_pcDefinition;
+
+			/*
+			 * Memory large enough for any behaviour of this library, holding the
+			 * behaviour of the active state of an instance.
+			 */
+			union UBehaviourStorage {
+				char Exploration[sizeof(AutoMoDeBehaviourExploration)];
+				char Stop[sizeof(AutoMoDeBehaviourStop)];
+				char Phototaxis[sizeof(AutoMoDeBehaviourPhototaxis)];
+				char AntiPhototaxis[sizeof(AutoMoDeBehaviourAntiPhototaxis)];
+				char Attraction[sizeof(AutoMoDeBehaviourAttraction)];
+				char Repulsion[sizeof(AutoMoDeBehaviourRepulsion)];
+				char GoToColor[sizeof(AutoMoDeBehaviourGoToColor)];
+				char GoAwayColor[sizeof(AutoMoDeBehaviourGoAwayColor)];
+				/* Alignment of the behaviours. */
+				double Real;
+				void* Pointer;
+			};
+			UBehaviourStorage m_uBehaviourStorage;
+
 			/*
 			 * Pointer to the behaviour associated with the active state of the FSM.
 			 */
 			AutoMoDeBehaviour* m_pcCurrentBehaviour;
 
 			/*
-			 * List of the conditions going out of the active state.
-			 * These conditions will be checked and determine the next state of the FSM.
+			 * A transition of the FSM: its condition, and the index of the
+			 * behaviour it leads to.
 			 */
-			std::vector<AutoMoDeCondition*> m_vecCurrentConditions;
+			struct STransition {
+				AutoMoDeCondition* Condition;
+				UInt32 Destination;
+			};
 
 			/*
-			 * Pointer to the object keeping track of the successive
-			 * states of the FSM.
+			 * Transition table, compiled by CompileTransitionTable(). The transitions going out of
+			 * state i are m_vecTransitions[m_vecTransitionOffsets[i]] up to
+			 * m_vecTransitions[m_vecTransitionOffsets[i + 1]] (excluded).
 			 */
-			AutoMoDeFsmHistory* m_pcHistory;
+			std::vector<UInt32> m_vecTransitionOffsets;
+			std::vector<STransition> m_vecTransitions;
+
+			/*
+			 * State of the robot read and written at each step: m_sOwnStepState, or the
+			 * one given to SetStepState().
+			 */
+			SStepState m_sOwnStepState;
+			SStepState* m_psStepState;
 
 			/*
-			 * The index of the behaviour corresponding to the current
-			 * active state of the FSM.
+			 * Pointer to the object keeping track of the successive
+			 * states of the FSM.
 			 */
-			UInt32 m_unCurrentBehaviourIndex;
+			AutoMoDeFsmHistory* m_pcHistory;
 
 			/*
 			 * Flag indicating if an history of the visited states
@@ -180,33 +323,45 @@ namespace argos {
 			std::string m_strHistoryFolder;
 
 			/*
-			 * Flag indicating if the FSM is changing state.
+			 * Pointer to the object representing the state of the robot.
+			 * @see EpuckDAO.
+			 */
+			EpuckDAO* m_pcRobotDAO;
+
+			/*
+			 * Copies the modules and the state of pc_fsm, into pc_arena if not NULL.
 			 */
-			bool m_bEnteringNewState;
+			void CopyFrom(const AutoMoDeFiniteStateMachine* pc_fsm, AutoMoDeArena* pc_arena);
 
 			/*
-			 * The current time step.
+			 * Makes the behaviour of state un_index the current behaviour of an instance,
+			 * copying it from the definition.
 			 */
-			UInt32 m_unTimeStep;
+			void LoadBehaviour(UInt32 un_index);
 
 			/*
-			 * Map containing pointers to tested outgoing conditions and
-			 * the result of the test.
-			 * @see AutoMoDeFsmHistory.
+			 * Destroys the current behaviour of an instance.
 			 */
-			std::map<AutoMoDeCondition*, bool> m_mapConditionsChecked;
+			void ReleaseBehaviour();
 
 			/*
-			 * Pointer to the object representing the state of the robot.
-			 * @see EpuckDAO.
+			 * Returns the FSM holding the transition table: the definition of an instance,
+			 * or the FSM itself.
 			 */
-			EpuckDAO* m_pcRobotDAO;
+			const AutoMoDeFiniteStateMachine* GetTransitionTableHolder() const;
 
 			/*
-			 * Returns a container filled conditions starting from the
-			 * current behaviour and finishing to possible future behaviours.
+			 * Selects the transitions starting from the current behaviour and
+			 * finishing to possible future behaviours.
 			 */
-			std::vector<AutoMoDeCondition*> GetOutgoingConditions();
+			void LoadOutgoingTransitions();
+
+			/*
+			 * Shuffles the order in which the transitions going out of the active state are
+			 * checked. The draws come from the random numbers of the robot, so that robots
+			 * stepped concurrently do not share any random state.
+			 */
+			void ShuffleTransitionOrder();
 
 			/*
 			 * Returns the DOT description of the initial state.
@@ -232,10 +387,22 @@ namespace argos {
 			AutoMoDeFsmHistory* GetHistory() const;
 
 			/**
-			 * Pass the pointer to the RobotDAO object to all modules part of the FSM.
+			 * Pass the pointer to the RobotDAO object, and to the random numbers of the
+			 * robot, to all modules part of the FSM.
 			 */
 			void ShareRobotDAO();
 
+			/*
+			 * Passes the pointer to the random numbers of the robot to the modules using them.
+			 */
+			void ShareRandomStream();
+
+			/*
+			 * Keys the random numbers of the robot with the seed of the experiment and
+			 * the identifier of the robot.
+			 */
+			void KeyRandomStream();
+
 			/*
 			 * Returns the flag indicating wether an history is maintained or not.
 			 */
@@ -0,0 +1,399 @@
+/*
+ * @file <src/core/AutoMoDeFsmBinary.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeFsmBinary.h"
+#include "AutoMoDeFsmBuilder.h"
+#include "AutoMoDeModuleCatalogue.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace argos {
+
+	/*
+	 * Layout of a compiled file. All fields are in the byte order of the machine, and all
+	 * records are multiples of 8 bytes. The header is followed by the offsets (UInt64) of
+	 * the configurations, plus the offset of the end of the last one.
+	 * A configuration is a SConfigurationRecord followed by its groups. A group is a
+	 * SGroupRecord followed by the identifiers of its robots (UInt32, padded to 8 bytes)
+	 * and by its states. A state is a SStateRecord followed by its parameters and its
+	 * transitions. A transition is a STransitionRecord followed by its parameters.
+	 */
+	static const char FSM_BINARY_MAGIC[8] = {'A', 'M', 'D', 'F', 'S', 'M', 'B', 'N'};
+
+	struct SHeader {
+		char Magic[8];
+		UInt32 Version;
+		UInt32 NumberConfigurations;
+	};
+
+	struct SConfigurationRecord {
+		UInt8 HasNumberGroups;
+		UInt8 GroupAssignment;
+		UInt16 Reserved;
+		UInt32 NumberGroups;
+		UInt32 NumberGroupRecords;
+		UInt32 Reserved2;
+	};
+
+	struct SGroupRecord {
+		UInt32 Flags;
+		UInt32 Size;
+		UInt32 NumberStates;
+		UInt32 NumberRobotIds;
+		UInt32 NumberStateRecords;
+		UInt32 Reserved;
+	};
+
+	struct SStateRecord {
+		UInt32 Behaviour;
+		UInt32 NumberTransitions;
+		UInt16 HasBehaviour;
+		UInt16 NumberParameters;
+		UInt32 NumberTransitionRecords;
+	};
+
+	struct STransitionRecord {
+		UInt32 Destination;
+		UInt32 Condition;
+		UInt16 Flags;
+		UInt16 NumberParameters;
+		UInt32 Reserved;
+	};
+
+	/* Parameter is a AutoMoDeParameters::EParameter. */
+	struct SParameterRecord {
+		UInt8 Parameter;
+		UInt8 Type;
+		UInt16 Reserved;
+		UInt32 Reserved2;
+		double Value;
+	};
+
+	/* Flags of SGroupRecord. */
+	static const UInt32 GROUP_HAS_SIZE = 1;
+	static const UInt32 GROUP_HAS_ROBOT_IDS = 2;
+	static const UInt32 GROUP_HAS_NUMBER_STATES = 4;
+
+	/* Flags of STransitionRecord. */
+	static const UInt16 TRANSITION_HAS_DESTINATION = 1;
+	static const UInt16 TRANSITION_HAS_CONDITION = 2;
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Appends a record to the content of a file.
+	 */
+	template <class T> static void Append(std::string& str_content, const T& t_record) {
+		str_content.append((const char*) &t_record, sizeof(T));
+	}
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Returns the records of the parameters that the module of description ps_description reads.
+	 */
+	static std::vector<SParameterRecord> SelectParameters(const SAutoMoDeModuleDescription* ps_description, const AutoMoDeParameters& c_parameters) {
+		std::vector<SParameterRecord> vecRecords;
+		for (UInt32 i = 0; i < ps_description->NumberParameters; ++i) {
+			AutoMoDeParameters::EParameter eParameter = ps_description->Parameters[i].Parameter;
+			if (c_parameters.Has(eParameter)) {
+				SParameterRecord sRecord;
+				memset(&sRecord, 0, sizeof(sRecord));
+				sRecord.Parameter = eParameter;
+				sRecord.Type = ps_description->Parameters[i].Type;
+				sRecord.Value = c_parameters.Get(eParameter);
+				vecRecords.push_back(sRecord);
+			}
+		}
+		return vecRecords;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Reads records from a mapped configuration, checking that they lie within it.
+	 */
+	class CRecordReader {
+		public:
+			CRecordReader(const char* pch_begin, const char* pch_end) :
+				m_pchCurrent(pch_begin),
+				m_pchEnd(pch_end) {}
+
+			template <class T> void Read(T& t_record) {
+				if ((size_t) (m_pchEnd - m_pchCurrent) < sizeof(T)) {
+					THROW_ARGOSEXCEPTION("Truncated compiled finite state machine");
+				}
+				memcpy(&t_record, m_pchCurrent, sizeof(T));
+				m_pchCurrent += sizeof(T);
+			}
+
+			void ReadParameters(UInt32 un_number_parameters, AutoMoDeParameters& c_parameters) {
+				for (UInt32 i = 0; i < un_number_parameters; ++i) {
+					SParameterRecord sRecord;
+					Read(sRecord);
+					if (sRecord.Parameter >= AutoMoDeParameters::NUMBER_PARAMETERS) {
+						THROW_ARGOSEXCEPTION("Unknown parameter " << (UInt32) sRecord.Parameter << " in compiled finite state machine");
+					}
+					c_parameters.Set((AutoMoDeParameters::EParameter) sRecord.Parameter, sRecord.Value);
+				}
+			}
+
+		private:
+			const char* m_pchCurrent;
+			const char* m_pchEnd;
+	};
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmBinary::AutoMoDeFsmBinary(const std::string& str_path) :
+		m_strPath(str_path),
+		m_pchMapping(NULL),
+		m_unMappedSize(0),
+		m_unNumberConfigurations(0) {
+		int nFileDescriptor = open(str_path.c_str(), O_RDONLY);
+		if (nFileDescriptor < 0) {
+			THROW_ARGOSEXCEPTION("Error opening the compiled finite state machine file \"" << str_path << "\"");
+		}
+		struct stat sStat;
+		SHeader sHeader;
+		bool bValid = (fstat(nFileDescriptor, &sStat) == 0)
+			&& (pread(nFileDescriptor, &sHeader, sizeof(sHeader), 0) == sizeof(sHeader))
+			&& memcmp(sHeader.Magic, FSM_BINARY_MAGIC, sizeof(FSM_BINARY_MAGIC)) == 0
+			&& sHeader.Version == VERSION
+			&& (UInt64) sStat.st_size >= sizeof(SHeader) + ((UInt64) sHeader.NumberConfigurations + 1) * sizeof(UInt64);
+		if (!bValid) {
+			close(nFileDescriptor);
+			THROW_ARGOSEXCEPTION("The file \"" << str_path << "\" is not a compiled finite state machine file of version " << VERSION);
+		}
+
+		m_unMappedSize = sStat.st_size;
+		void* ptMapping = mmap(NULL, m_unMappedSize, PROT_READ, MAP_PRIVATE, nFileDescriptor, 0);
+		// The mapping stays valid once the file is closed.
+		close(nFileDescriptor);
+		if (ptMapping == MAP_FAILED) {
+			THROW_ARGOSEXCEPTION("Error mapping the compiled finite state machine file \"" << str_path << "\"");
+		}
+		m_pchMapping = (const char*) ptMapping;
+		m_unNumberConfigurations = sHeader.NumberConfigurations;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmBinary::~AutoMoDeFsmBinary() {
+		if (m_pchMapping != NULL) {
+			munmap((void*) m_pchMapping, m_unMappedSize);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	UInt32 AutoMoDeFsmBinary::GetNumberConfigurations() const {
+		return m_unNumberConfigurations;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmBinary::Load(UInt32 un_index, AutoMoDeFsmConfig& c_fsm_config) const {
+		if (un_index >= m_unNumberConfigurations) {
+			THROW_ARGOSEXCEPTION("No configuration " << un_index << " in \"" << m_strPath << "\", which holds " << m_unNumberConfigurations);
+		}
+		UInt64 punOffsets[2];
+		memcpy(punOffsets, m_pchMapping + sizeof(SHeader) + un_index * sizeof(UInt64), sizeof(punOffsets));
+		if (punOffsets[0] > punOffsets[1] || punOffsets[1] > m_unMappedSize) {
+			THROW_ARGOSEXCEPTION("Corrupted compiled finite state machine file \"" << m_strPath << "\"");
+		}
+		CRecordReader cReader(m_pchMapping + punOffsets[0], m_pchMapping + punOffsets[1]);
+
+		c_fsm_config = AutoMoDeFsmConfig();
+		SConfigurationRecord sConfiguration;
+		cReader.Read(sConfiguration);
+		c_fsm_config.m_bHasNumberGroups = (sConfiguration.HasNumberGroups != 0);
+		c_fsm_config.m_unNumberGroups = sConfiguration.NumberGroups;
+		c_fsm_config.m_eGroupAssignment = (AutoMoDeFsmConfig::EGroupAssignment) sConfiguration.GroupAssignment;
+		for (UInt32 g = 0; g < sConfiguration.NumberGroupRecords; ++g) {
+			SGroupRecord sGroupRecord;
+			cReader.Read(sGroupRecord);
+			c_fsm_config.m_vecGroups.push_back(AutoMoDeFsmConfig::SGroup());
+			AutoMoDeFsmConfig::SGroup& sGroup = c_fsm_config.m_vecGroups.back();
+			sGroup.HasSize = (sGroupRecord.Flags & GROUP_HAS_SIZE) != 0;
+			sGroup.Size = sGroupRecord.Size;
+			sGroup.HasRobotIds = (sGroupRecord.Flags & GROUP_HAS_ROBOT_IDS) != 0;
+			sGroup.HasNumberStates = (sGroupRecord.Flags & GROUP_HAS_NUMBER_STATES) != 0;
+			sGroup.NumberStates = sGroupRecord.NumberStates;
+			for (UInt32 i = 0; i < sGroupRecord.NumberRobotIds; ++i) {
+				UInt32 unRobotId;
+				cReader.Read(unRobotId);
+				sGroup.RobotIds.push_back(unRobotId);
+			}
+			if (sGroupRecord.NumberRobotIds % 2 != 0) {
+				UInt32 unPadding;
+				cReader.Read(unPadding);
+			}
+			for (UInt32 j = 0; j < sGroupRecord.NumberStateRecords; ++j) {
+				SStateRecord sStateRecord;
+				cReader.Read(sStateRecord);
+				sGroup.States.push_back(AutoMoDeFsmConfig::SState());
+				AutoMoDeFsmConfig::SState& sState = sGroup.States.back();
+				sState.HasBehaviour = (sStateRecord.HasBehaviour != 0);
+				sState.Behaviour = sStateRecord.Behaviour;
+				sState.NumberTransitions = sStateRecord.NumberTransitions;
+				cReader.ReadParameters(sStateRecord.NumberParameters, sState.Parameters);
+				for (UInt32 k = 0; k < sStateRecord.NumberTransitionRecords; ++k) {
+					STransitionRecord sTransitionRecord;
+					cReader.Read(sTransitionRecord);
+					sState.Transitions.push_back(AutoMoDeFsmConfig::STransition());
+					AutoMoDeFsmConfig::STransition& sTransition = sState.Transitions.back();
+					sTransition.HasDestination = (sTransitionRecord.Flags & TRANSITION_HAS_DESTINATION) != 0;
+					sTransition.Destination = sTransitionRecord.Destination;
+					sTransition.HasCondition = (sTransitionRecord.Flags & TRANSITION_HAS_CONDITION) != 0;
+					sTransition.Condition = sTransitionRecord.Condition;
+					cReader.ReadParameters(sTransitionRecord.NumberParameters, sTransition.Parameters);
+				}
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeFsmBinary::IsFsmBinary(const std::string& str_path) {
+		char pchMagic[sizeof(FSM_BINARY_MAGIC)];
+		FILE* ptFile = fopen(str_path.c_str(), "rb");
+		if (ptFile == NULL) {
+			return false;
+		}
+		bool bIsFsmBinary = (fread(pchMagic, 1, sizeof(pchMagic), ptFile) == sizeof(pchMagic))
+			&& memcmp(pchMagic, FSM_BINARY_MAGIC, sizeof(FSM_BINARY_MAGIC)) == 0;
+		fclose(ptFile);
+		return bIsFsmBinary;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmBinary::Write(const std::string& str_path, const std::vector<AutoMoDeFsmConfig>& vec_fsm_configs) {
+		std::string strContent;
+		SHeader sHeader;
+		memset(&sHeader, 0, sizeof(sHeader));
+		memcpy(sHeader.Magic, FSM_BINARY_MAGIC, sizeof(FSM_BINARY_MAGIC));
+		sHeader.Version = VERSION;
+		sHeader.NumberConfigurations = vec_fsm_configs.size();
+		Append(strContent, sHeader);
+		// The offsets are filled in once the configurations are written.
+		strContent.append((vec_fsm_configs.size() + 1) * sizeof(UInt64), '\0');
+
+		for (UInt32 c = 0; c < vec_fsm_configs.size(); ++c) {
+			const AutoMoDeFsmConfig& cFsmConfig = vec_fsm_configs.at(c);
+			UInt64 unOffset = strContent.size();
+			memcpy(&strContent[sizeof(SHeader) + c * sizeof(UInt64)], &unOffset, sizeof(unOffset));
+
+			SConfigurationRecord sConfiguration;
+			memset(&sConfiguration, 0, sizeof(sConfiguration));
+			sConfiguration.HasNumberGroups = cFsmConfig.HasNumberGroups();
+			sConfiguration.GroupAssignment = cFsmConfig.GetGroupAssignment();
+			sConfiguration.NumberGroups = cFsmConfig.GetNumberGroups();
+			sConfiguration.NumberGroupRecords = cFsmConfig.GetGroups().size();
+			Append(strContent, sConfiguration);
+
+			for (UInt32 g = 0; g < cFsmConfig.GetGroups().size(); ++g) {
+				const AutoMoDeFsmConfig::SGroup& sGroup = cFsmConfig.GetGroups().at(g);
+				if (sGroup.HasNumberStates) {
+					try {
+						AutoMoDeFsmBuilder cBuilder;
+						cBuilder.BuildFiniteStateMachine(sGroup);
+					} catch (CARGoSException& ex) {
+						THROW_ARGOSEXCEPTION_NESTED("Could not build group " << g << " of configuration " << c, ex);
+					}
+				}
+				// Only the states and transitions the builder reads are kept.
+				UInt32 unNumberStates = (sGroup.HasNumberStates ? std::min<size_t>(sGroup.NumberStates, sGroup.States.size()) : 0);
+				SGroupRecord sGroupRecord;
+				memset(&sGroupRecord, 0, sizeof(sGroupRecord));
+				sGroupRecord.Flags = (sGroup.HasSize ? GROUP_HAS_SIZE : 0) | (sGroup.HasRobotIds ? GROUP_HAS_ROBOT_IDS : 0) | (sGroup.HasNumberStates ? GROUP_HAS_NUMBER_STATES : 0);
+				sGroupRecord.Size = sGroup.Size;
+				sGroupRecord.NumberStates = sGroup.NumberStates;
+				sGroupRecord.NumberRobotIds = sGroup.RobotIds.size();
+				sGroupRecord.NumberStateRecords = unNumberStates;
+				Append(strContent, sGroupRecord);
+				for (UInt32 i = 0; i < sGroup.RobotIds.size(); ++i) {
+					Append(strContent, sGroup.RobotIds.at(i));
+				}
+				if (sGroup.RobotIds.size() % 2 != 0) {
+					Append(strContent, (UInt32) 0);
+				}
+
+				for (UInt32 j = 0; j < unNumberStates; ++j) {
+					const AutoMoDeFsmConfig::SState& sState = sGroup.States.at(j);
+					const SAutoMoDeModuleDescription* psDescription = (sState.HasBehaviour ? GetBehaviourDescription(sState.Behaviour) : NULL);
+					std::vector<SParameterRecord> vecParameters;
+					SStateRecord sStateRecord;
+					memset(&sStateRecord, 0, sizeof(sStateRecord));
+					if (psDescription != NULL) {
+						vecParameters = SelectParameters(psDescription, sState.Parameters);
+						sStateRecord.HasBehaviour = 1;
+						sStateRecord.Behaviour = sState.Behaviour;
+						sStateRecord.NumberTransitions = sState.NumberTransitions;
+						sStateRecord.NumberParameters = vecParameters.size();
+						sStateRecord.NumberTransitionRecords = sState.NumberTransitions;
+					}
+					Append(strContent, sStateRecord);
+					for (UInt32 i = 0; i < vecParameters.size(); ++i) {
+						Append(strContent, vecParameters.at(i));
+					}
+					if (psDescription == NULL) {
+						continue;
+					}
+
+					for (UInt32 k = 0; k < sState.NumberTransitions; ++k) {
+						// The builder checked that the transition is complete and its condition known.
+						const AutoMoDeFsmConfig::STransition& sTransition = sState.Transitions.at(k);
+						vecParameters = SelectParameters(GetConditionDescription(sTransition.Condition), sTransition.Parameters);
+						STransitionRecord sTransitionRecord;
+						memset(&sTransitionRecord, 0, sizeof(sTransitionRecord));
+						sTransitionRecord.Flags = TRANSITION_HAS_DESTINATION | TRANSITION_HAS_CONDITION;
+						sTransitionRecord.Destination = sTransition.Destination;
+						sTransitionRecord.Condition = sTransition.Condition;
+						sTransitionRecord.NumberParameters = vecParameters.size();
+						Append(strContent, sTransitionRecord);
+						for (UInt32 i = 0; i < vecParameters.size(); ++i) {
+							Append(strContent, vecParameters.at(i));
+						}
+					}
+				}
+			}
+		}
+		UInt64 unEnd = strContent.size();
+		memcpy(&strContent[sizeof(SHeader) + vec_fsm_configs.size() * sizeof(UInt64)], &unEnd, sizeof(unEnd));
+
+		// Written aside, then renamed, so that readers never map a partial file.
+		std::string strTemporaryPath = str_path + ".tmp";
+		FILE* ptFile = fopen(strTemporaryPath.c_str(), "wb");
+		if (ptFile == NULL) {
+			THROW_ARGOSEXCEPTION("Error opening file \"" << strTemporaryPath << "\"");
+		}
+		bool bWritten = (fwrite(strContent.data(), 1, strContent.size(), ptFile) == strContent.size());
+		bWritten = (fclose(ptFile) == 0) && bWritten;
+		if (!bWritten || rename(strTemporaryPath.c_str(), str_path.c_str()) != 0) {
+			unlink(strTemporaryPath.c_str());
+			THROW_ARGOSEXCEPTION("Error writing file \"" << str_path << "\"");
+		}
+	}
+}
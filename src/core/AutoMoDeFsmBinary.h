@@ -0,0 +1,87 @@
+/*
+ * @file <src/core/AutoMoDeFsmBinary.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class reads and writes compiled finite state machine files.
+ * 				A compiled file holds any number of swarm-wide configurations,
+ * 				each with its groups, their states (behaviour and typed
+ * 				parameters) and their transitions (destination, condition and
+ * 				typed parameters), in a versioned binary format. Only the
+ * 				configurations whose finite state machines can be built are
+ * 				written, and only the parameters the modules read are kept.
+ * 				The file is mapped in memory when read: loading a configuration
+ * 				involves no text parsing.
+ */
+
+#ifndef AUTOMODE_FSM_BINARY_H
+#define AUTOMODE_FSM_BINARY_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+
+#include "AutoMoDeFsmConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace argos {
+	class AutoMoDeFsmBinary {
+		public:
+			/*
+			 * Opens and maps the compiled file str_path.
+			 */
+			AutoMoDeFsmBinary(const std::string& str_path);
+
+			/*
+			 * Class destructor.
+			 */
+			virtual ~AutoMoDeFsmBinary();
+
+			/*
+			 * Returns the number of configurations in the file.
+			 */
+			UInt32 GetNumberConfigurations() const;
+
+			/*
+			 * Fills c_fsm_config with the configuration un_index of the file.
+			 */
+			void Load(UInt32 un_index, AutoMoDeFsmConfig& c_fsm_config) const;
+
+			/*
+			 * Returns whether str_path starts like a compiled file.
+			 */
+			static bool IsFsmBinary(const std::string& str_path);
+
+			/*
+			 * Builds the finite state machines of the configurations, and writes the
+			 * configurations to the compiled file str_path. Throws if a configuration cannot
+			 * be built, in which case no file is written.
+			 */
+			static void Write(const std::string& str_path, const std::vector<AutoMoDeFsmConfig>& vec_fsm_configs);
+
+			/*
+			 * Version of the format, increased at each incompatible change.
+			 */
+			static const UInt32 VERSION = 1;
+
+		private:
+			/*
+			 * Copying would unmap the file twice.
+			 */
+			AutoMoDeFsmBinary(const AutoMoDeFsmBinary&);
+			AutoMoDeFsmBinary& operator=(const AutoMoDeFsmBinary&);
+
+			std::string m_strPath;
+
+			const char* m_pchMapping;
+
+			size_t m_unMappedSize;
+
+			UInt32 m_unNumberConfigurations;
+	};
+}
+
+#endif
@@ -16,7 +16,7 @@ namespace argos {
 	/****************************************/
 
 	AutoMoDeFsmBuilder::AutoMoDeFsmBuilder() {
-		unRobotStartId = 0;
+		cFiniteStateMachine = NULL;
 	}
 
 	/****************************************/
@@ -30,98 +30,78 @@ namespace argos {
 	/****************************************/
 
 	AutoMoDeFiniteStateMachine* AutoMoDeFsmBuilder::BuildFiniteStateMachine(const std::string& str_fsm_config) {
-		std::istringstream iss(str_fsm_config);
-		std::vector<std::string> tokens;
-		copy(std::istream_iterator<std::string>(iss),
-			std::istream_iterator<std::string>(),
-			std::back_inserter(tokens));
-		return BuildFiniteStateMachine(tokens);
+		AutoMoDeFsmConfig cFsmConfig;
+		try {
+			cFsmConfig.Parse(str_fsm_config);
+		} catch (std::exception& ex) {
+			THROW_ARGOSEXCEPTION_NESTED("Could not create the Finite State Machine: Error while parsing.", ex);
+		}
+		return BuildFiniteStateMachine(cFsmConfig);
 	}
 
 	/****************************************/
 	/****************************************/
 
 	AutoMoDeFiniteStateMachine* AutoMoDeFsmBuilder::BuildFiniteStateMachine(std::vector<std::string>& vec_fsm_config) {
-		cFiniteStateMachine = new AutoMoDeFiniteStateMachine();
-
-		std::vector<std::string>::iterator states_it;
-		std::vector<std::string>::iterator gropus_it;
+		std::string strFsmConfig;
+		for (UInt32 i = 0; i < vec_fsm_config.size(); ++i) {
+			strFsmConfig += vec_fsm_config.at(i) + " ";
+		}
+		return BuildFiniteStateMachine(strFsmConfig);
+	}
 
-		try {
+	/****************************************/
+	/****************************************/
 
-			// Extract group index from --nstates_<group_id>
-			for (auto it = vec_fsm_config.begin(); it != vec_fsm_config.end(); ++it) {
-				if (it->rfind("--nstates_", 0) == 0) {
-					std::string group_suffix = it->substr(10); // after "--nstates_"
-					unGroupId = std::stoi(group_suffix);
-					m_unNumberStates = std::stoi(*(it + 1));
-					break;
-				}
+	AutoMoDeFiniteStateMachine* AutoMoDeFsmBuilder::BuildFiniteStateMachine(const AutoMoDeFsmConfig& c_fsm_config) {
+		const std::vector<AutoMoDeFsmConfig::SGroup>& vecGroups = c_fsm_config.GetGroups();
+		for (UInt32 i = 0; i < vecGroups.size(); ++i) {
+			if (vecGroups.at(i).HasNumberStates) {
+				return BuildFiniteStateMachine(vecGroups.at(i));
 			}
+		}
+		THROW_ARGOSEXCEPTION("Could not find --nstates_<group_id> in FSM configuration.");
+	}
 
-			// std::cout << "FSM Configuration:" << std::endl;
-			// for (size_t i = 0; i < vec_fsm_config.size(); ++i) {
-			// 	std::cout << " " << vec_fsm_config[i];
-			// }
-			// std::cout << std::endl;
-
-
-
-			if (unGroupId == (UInt32)-1) {
-				THROW_ARGOSEXCEPTION("Could not find --nstates_<group_id> in FSM configuration.");
-			}
+	/****************************************/
+	/****************************************/
 
-			// Create and fill FSM
-			// HandleGroup(cFiniteStateMachine, vec_fsm_config);
-
-			for (UInt32 j = 0; j < m_unNumberStates; ++j) {
-				std::ostringstream ossStart;
-				ossStart << "--s" << j << "_" << unGroupId;
-				auto itStart = std::find(vec_fsm_config.begin(), vec_fsm_config.end(), ossStart.str());
-
-				std::vector<std::string>::iterator itEnd;
-				if (j + 1 < m_unNumberStates) {
-					std::ostringstream ossEnd;
-					ossEnd << "--s" << (j + 1) << "_" << unGroupId;
-					itEnd = std::find(vec_fsm_config.begin(), vec_fsm_config.end(), ossEnd.str());
-				} else {
-					itEnd = vec_fsm_config.end();
-				}
+	AutoMoDeFiniteStateMachine* AutoMoDeFsmBuilder::BuildFiniteStateMachine(const AutoMoDeFsmConfig::SGroup& s_group) {
+		// The builder only owns the last finite state machine it built.
+		delete cFiniteStateMachine;
+		cFiniteStateMachine = new AutoMoDeFiniteStateMachine();
+		m_strCanonicalForm.clear();
+		m_unNumberStates = s_group.NumberStates;
 
-				if (itStart != vec_fsm_config.end()) {
-					std::vector<std::string> vecStateConfig(itStart, itEnd);
-					HandleState(cFiniteStateMachine, vecStateConfig);
+		try {
+			// States that are not described in the configuration are left out.
+			for (UInt32 j = 0; j < m_unNumberStates && j < s_group.States.size(); ++j) {
+				if (s_group.States.at(j).HasBehaviour) {
+					HandleState(cFiniteStateMachine, s_group.States.at(j), j);
 				}
 			}
 		}
-		catch (std::exception e) {
-			THROW_ARGOSEXCEPTION("Could not create the Finite State Machine: Error while parsing.");
+		catch (std::exception& ex) {
+			THROW_ARGOSEXCEPTION_NESTED("Could not create the Finite State Machine: Error while parsing.", ex);
 		}
+		cFiniteStateMachine->CompileTransitionTable();
 
 		return cFiniteStateMachine;
-
-	}
-
-	/****************************************/
-	/****************************************/
-
-	void AutoMoDeFsmBuilder::HandleGroup(AutoMoDeFiniteStateMachine* c_fsm, std::vector<std::string>& vec_fsm_state_config) {
-		// Extraction of the id of group
-		unGroupId =  atoi((*vec_fsm_state_config.begin()).substr(3,4).c_str());
-		// Extraction of the number of robots
-		unGroupRobots  =  atoi((*(vec_fsm_state_config.begin()+1)).c_str());
 	}
 
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeFsmBuilder::HandleState(AutoMoDeFiniteStateMachine* c_fsm, std::vector<std::string>& vec_fsm_state_config) {
+	void AutoMoDeFsmBuilder::HandleState(AutoMoDeFiniteStateMachine* c_fsm, const AutoMoDeFsmConfig::SState& s_state, const UInt32& un_state_index) {
 		AutoMoDeBehaviour* cNewBehaviour;
-		std::vector<std::string>::iterator it;
-		// Extraction of the index of the behaviour in the FSM
-		UInt8 unBehaviourIndex =  atoi((*vec_fsm_state_config.begin()).substr(3,4).c_str());
-		// Extraction of the identifier of the behaviour
-		UInt8 unBehaviourIdentifier =  atoi((*(vec_fsm_state_config.begin()+1)).c_str());
+		UInt32 unBehaviourIdentifier = s_state.Behaviour;
+
+		const SAutoMoDeModuleDescription* psDescription = GetBehaviourDescription(unBehaviourIdentifier);
+		if (psDescription == NULL) {
+			THROW_ARGOSEXCEPTION("Unknown behaviour " << unBehaviourIdentifier);
+		}
+		std::ostringstream ossCanonical;
+		ossCanonical << "s" << un_state_index << "=" << unBehaviourIdentifier << "(";
 
 		// Creation of the Behaviour object
 		switch(unBehaviourIdentifier) {
@@ -150,135 +130,157 @@ namespace argos {
                 cNewBehaviour = new AutoMoDeBehaviourGoAwayColor();
                 break;
 		}
-		cNewBehaviour->SetIndex(unBehaviourIndex);
+		cNewBehaviour->SetIndex(un_state_index);
 		cNewBehaviour->SetIdentifier(unBehaviourIdentifier);
 
-		// Checking for parameters
-        std::string vecPossibleParameters[] = {"rwm", "att", "rep", "cle", "clr", "vel"};
-		UInt8 unNumberPossibleParameters = sizeof(vecPossibleParameters) / sizeof(vecPossibleParameters[0]);
-		for (UInt8 i = 0; i < unNumberPossibleParameters; i++) {
-			std::string strCurrentParameter = vecPossibleParameters[i];
-			std::ostringstream oss;
-			oss << "--" <<strCurrentParameter << unBehaviourIndex << "_" << unGroupId;
-			it = std::find(vec_fsm_state_config.begin(), vec_fsm_state_config.end(), oss.str());
-			if (it != vec_fsm_state_config.end()) {
-				Real fCurrentParameterValue = strtod((*(it+1)).c_str(), NULL);
-				cNewBehaviour->AddParameter(strCurrentParameter, fCurrentParameterValue);
+		// Checking for parameters. Only the parameters the behaviour reads are kept.
+		for (UInt32 i = 0; i < psDescription->NumberParameters; i++) {
+			AutoMoDeParameters::EParameter eCurrentParameter = psDescription->Parameters[i].Parameter;
+			if (s_state.Parameters.Has(eCurrentParameter)) {
+				Real fCurrentParameterValue = s_state.Parameters.Get(eCurrentParameter);
+				cNewBehaviour->AddParameter(eCurrentParameter, fCurrentParameterValue);
+				ossCanonical << (i > 0 ? "," : "") << AutoMoDeParameters::GetName(eCurrentParameter) << "=" << FormatParameterValue(psDescription->Parameters[i].Type, fCurrentParameterValue);
 			}
 		}
+		ossCanonical << ")";
 		cNewBehaviour->Init();
 		// Add the constructed Behaviour to the FSM
 		c_fsm->AddBehaviour(cNewBehaviour);
+		m_strCanonicalForm += ossCanonical.str() + ";";
 
 		/*
-		 * Extract the transitions starting from the state and
-		 * pass them to the transition handler, if they exist.
+		 * Create the transitions starting from the state, if they exist.
 		 */
-		std::ostringstream oss;
-		oss << "--n" << unBehaviourIndex << "_" <<unGroupId;
-		it = std::find(vec_fsm_state_config.begin(), vec_fsm_state_config.end(), oss.str());
-		if (it != vec_fsm_state_config.end()) {
-			UInt8 unNumberTransitions = atoi((*(it+1)).c_str());
-
-			std::vector<std::string>::iterator first_transition;
-			std::vector<std::string>::iterator second_transition;
-
-			for (UInt8 i = 0; i < unNumberTransitions; i++) {
-				std::ostringstream oss;
-				oss << "--n" << unBehaviourIndex << "x" << i << "_" <<unGroupId;
-				first_transition = std::find(vec_fsm_state_config.begin(), vec_fsm_state_config.end(), oss.str());
-				if (i+1 < unNumberTransitions) {
-					std::ostringstream oss;
-					oss << "--n" << unBehaviourIndex << "x" << i+1 << "_" <<unGroupId;
-					second_transition = std::find(vec_fsm_state_config.begin(), vec_fsm_state_config.end(), oss.str());
-				} else {
-					second_transition = vec_fsm_state_config.end();
+		std::vector<std::pair<std::string, AutoMoDeCondition*> > vecTransitions;
+		for (UInt32 i = 0; i < s_state.NumberTransitions; i++) {
+			std::string strCanonicalTransition;
+			AutoMoDeCondition* cNewCondition = NULL;
+			try {
+				if (i >= s_state.Transitions.size()) {
+					THROW_ARGOSEXCEPTION("Missing transition " << i << " of state " << un_state_index);
 				}
-				std::vector<std::string> vecTransitionConfig(first_transition, second_transition);
-				HandleTransition(vecTransitionConfig, unBehaviourIndex, i);
+				cNewCondition = HandleTransition(s_state.Transitions.at(i), un_state_index, i, strCanonicalTransition);
+			} catch (std::exception& ex) {
+				for (UInt32 j = 0; j < vecTransitions.size(); j++) {
+					delete vecTransitions.at(j).second;
+				}
+				throw;
 			}
+			vecTransitions.push_back(std::make_pair(strCanonicalTransition, cNewCondition));
+		}
+
+		/*
+		 * The order in which the transitions are listed in the configuration is irrelevant:
+		 * they are added in the order of their canonical form, so that equivalent
+		 * configurations also behave identically with the same random seed.
+		 */
+		std::stable_sort(vecTransitions.begin(), vecTransitions.end(), CompareTransitions);
+		for (UInt32 i = 0; i < vecTransitions.size(); i++) {
+			vecTransitions.at(i).second->SetIndex(i);
+			cFiniteStateMachine->AddCondition(vecTransitions.at(i).second);
+			m_strCanonicalForm += vecTransitions.at(i).first + ";";
 		}
 	}
 
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeFsmBuilder::HandleTransition(std::vector<std::string>& vec_fsm_transition_config, const UInt32& un_initial_state_index, const UInt32& un_condition_index) {
-		AutoMoDeCondition* cNewCondition;
-
-		std::stringstream ss;
-		ss << "--n" << un_initial_state_index << "x" << un_condition_index << "_" <<unGroupId;
-		std::vector<UInt32> vecPossibleDestinationIndex = GetPossibleDestinationBehaviour(un_initial_state_index);
-		std::vector<std::string>::iterator it;
-		it = std::find(vec_fsm_transition_config.begin(), vec_fsm_transition_config.end(), ss.str());
-
-		// TODO: Check here whether unToBehaviour is smaller than the total number of states.
-		UInt32 unIndexBehaviour = atoi((*(it+1)).c_str());
-		UInt32 unToBehaviour = vecPossibleDestinationIndex.at(unIndexBehaviour);
-		if (unToBehaviour < m_unNumberStates) {
-			ss.str(std::string());
-			ss << "--c" << un_initial_state_index << "x" << un_condition_index << "_" <<unGroupId;
-			it = std::find(vec_fsm_transition_config.begin(), vec_fsm_transition_config.end(), ss.str());
-
-			UInt8 unConditionIdentifier = atoi((*(it+1)).c_str());
-
-			switch(unConditionIdentifier) {
-				case 0:
-					cNewCondition = new AutoMoDeConditionBlackFloor();
-					break;
-				case 1:
-					cNewCondition = new AutoMoDeConditionGrayFloor();
-					break;
-				case 2:
-					cNewCondition = new AutoMoDeConditionWhiteFloor();
-					break;
-				case 3:
-					cNewCondition = new AutoMoDeConditionNeighborsCount();
-					break;
-				case 4:
-					cNewCondition = new AutoMoDeConditionInvertedNeighborsCount();
-					break;
-				case 5:
-					cNewCondition = new AutoMoDeConditionFixedProbability();
-					break;
-                case 7:
-                    cNewCondition = new AutoMoDeConditionProbColor();
-                    break;
-			}
+	bool AutoMoDeFsmBuilder::CompareTransitions(const std::pair<std::string, AutoMoDeCondition*>& c_first, const std::pair<std::string, AutoMoDeCondition*>& c_second) {
+		return c_first.first < c_second.first;
+	}
 
-			cNewCondition->SetOriginAndExtremity(un_initial_state_index, unToBehaviour);
-			cNewCondition->SetIndex(un_condition_index);
-			cNewCondition->SetIdentifier(unConditionIdentifier);
-
-
-			// Checking for parameters
-            std::string vecPossibleParameters[] = {"p", "w", "l"};
-			UInt8 unNumberPossibleParameters = sizeof(vecPossibleParameters) / sizeof(vecPossibleParameters[0]);
-			for (UInt8 i = 0; i < unNumberPossibleParameters; i++) {
-				std::string strCurrentParameter = vecPossibleParameters[i];
-				ss.str(std::string());
-				ss << "--" << strCurrentParameter << un_initial_state_index << "x" << un_condition_index << "_" <<unGroupId;
-				it = std::find(vec_fsm_transition_config.begin(), vec_fsm_transition_config.end(), ss.str());
-				if (it != vec_fsm_transition_config.end()) {
-					Real fCurrentParameterValue = strtod((*(it+1)).c_str(), NULL);
-					cNewCondition->AddParameter(strCurrentParameter, fCurrentParameterValue);
-				}
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeCondition* AutoMoDeFsmBuilder::HandleTransition(const AutoMoDeFsmConfig::STransition& s_transition, const UInt32& un_initial_state_index, const UInt32& un_condition_index, std::string& str_canonical_form) {
+		AutoMoDeCondition* cNewCondition = NULL;
+
+		if (!s_transition.HasDestination || !s_transition.HasCondition) {
+			THROW_ARGOSEXCEPTION("Incomplete transition " << un_condition_index << " of state " << un_initial_state_index);
+		}
+		/*
+		 * The destination is given among the states other than the initial one.
+		 * Added for compatibility with irace interdependent parameters.
+		 */
+		if (s_transition.Destination >= m_unNumberStates - 1) {
+			THROW_ARGOSEXCEPTION("Transition " << un_condition_index << " of state " << un_initial_state_index << " leads to a state that does not exist");
+		}
+		UInt32 unToBehaviour = (s_transition.Destination < un_initial_state_index ? s_transition.Destination : s_transition.Destination + 1);
+
+		UInt32 unConditionIdentifier = s_transition.Condition;
+		const SAutoMoDeModuleDescription* psDescription = GetConditionDescription(unConditionIdentifier);
+		if (psDescription == NULL) {
+			THROW_ARGOSEXCEPTION("Unknown condition " << unConditionIdentifier);
+		}
+		std::ostringstream ossCanonical;
+		ossCanonical << "t" << un_initial_state_index << ">" << unToBehaviour << "=" << unConditionIdentifier << "(";
+
+		switch(unConditionIdentifier) {
+			case 0:
+				cNewCondition = new AutoMoDeConditionBlackFloor();
+				break;
+			case 1:
+				cNewCondition = new AutoMoDeConditionGrayFloor();
+				break;
+			case 2:
+				cNewCondition = new AutoMoDeConditionWhiteFloor();
+				break;
+			case 3:
+				cNewCondition = new AutoMoDeConditionNeighborsCount();
+				break;
+			case 4:
+				cNewCondition = new AutoMoDeConditionInvertedNeighborsCount();
+				break;
+			case 5:
+				cNewCondition = new AutoMoDeConditionFixedProbability();
+				break;
+            case 7:
+                cNewCondition = new AutoMoDeConditionProbColor();
+                break;
+		}
+
+		cNewCondition->SetOriginAndExtremity(un_initial_state_index, unToBehaviour);
+		cNewCondition->SetIndex(un_condition_index);
+		cNewCondition->SetIdentifier(unConditionIdentifier);
+
+		// Checking for parameters. Only the parameters the condition reads are kept.
+		for (UInt32 i = 0; i < psDescription->NumberParameters; i++) {
+			AutoMoDeParameters::EParameter eCurrentParameter = psDescription->Parameters[i].Parameter;
+			if (s_transition.Parameters.Has(eCurrentParameter)) {
+				Real fCurrentParameterValue = s_transition.Parameters.Get(eCurrentParameter);
+				cNewCondition->AddParameter(eCurrentParameter, fCurrentParameterValue);
+				ossCanonical << (i > 0 ? "," : "") << AutoMoDeParameters::GetName(eCurrentParameter) << "=" << FormatParameterValue(psDescription->Parameters[i].Type, fCurrentParameterValue);
 			}
+		}
+		ossCanonical << ")";
+		str_canonical_form = ossCanonical.str();
+		try {
 			cNewCondition->Init();
-			cFiniteStateMachine->AddCondition(cNewCondition);
+		} catch (std::exception& ex) {
+			delete cNewCondition;
+			throw;
 		}
+		return cNewCondition;
 	}
 
 	/****************************************/
 	/****************************************/
 
-	const std::vector<UInt32> AutoMoDeFsmBuilder::GetPossibleDestinationBehaviour(const UInt32& un_initial_state_index) {
-		std::vector<UInt32> vecPossibleDestinationIndex;
-		for (UInt32 i = 0; i < m_unNumberStates; i++) {
-			if (i != un_initial_state_index) {
-				vecPossibleDestinationIndex.push_back(i);
-			}
-		}
-		return vecPossibleDestinationIndex;
+	const AutoMoDeFiniteStateMachine* AutoMoDeFsmBuilder::GetFiniteStateMachine() const {
+		return cFiniteStateMachine;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const std::string& AutoMoDeFsmBuilder::GetCanonicalForm() const {
+		return m_strCanonicalForm;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	SAutoMoDeDigest AutoMoDeFsmBuilder::GetStructuralHash() const {
+		return AutoMoDeHash::Digest(m_strCanonicalForm);
 	}
 }
@@ -17,6 +17,9 @@
 #define AUTOMODE_FSM_BUILDER_H
 
 #include "AutoMoDeFiniteStateMachine.h"
+#include "AutoMoDeFsmConfig.h"
+#include "AutoMoDeHash.h"
+#include "AutoMoDeModuleCatalogue.h"
 
 #include <argos3/core/utility/logging/argos_log.h>
 #include <algorithm>
@@ -46,45 +49,66 @@ namespace argos {
 			 */
 			AutoMoDeFiniteStateMachine* BuildFiniteStateMachine(const std::string& str_fsm_config);
 
+			/**
+			 * Creates an AutoMoDeFiniteStateMachine based on a parsed configuration. The first
+			 * group of the configuration that gives its number of states is built.
+			 */
+			AutoMoDeFiniteStateMachine* BuildFiniteStateMachine(const AutoMoDeFsmConfig& c_fsm_config);
+
+			/**
+			 * Creates an AutoMoDeFiniteStateMachine based on the parsed configuration of a group.
+			 */
+			AutoMoDeFiniteStateMachine* BuildFiniteStateMachine(const AutoMoDeFsmConfig::SGroup& s_group);
+
 			/*
 			 * Class destructor.
 			 */
 			virtual ~AutoMoDeFsmBuilder();
 
+			/*
+			 * Returns the last finite state machine built, which the builder owns.
+			 */
+			const AutoMoDeFiniteStateMachine* GetFiniteStateMachine() const;
+
+			/*
+			 * Returns the canonical form of the last finite state machine built. Configurations
+			 * that lead to the same finite state machine share their canonical form: the
+			 * parameters the modules do not read are left out, the values are written as the
+			 * modules read them, and the transitions of each state are sorted.
+			 */
+			const std::string& GetCanonicalForm() const;
+
+			/*
+			 * Returns the 128-bit digest of the canonical form of the last finite state machine built.
+			 */
+			SAutoMoDeDigest GetStructuralHash() const;
+
 
 		private:
 			/**
 			 * Creates a AutoMoDeBehaviour from a state configuration and add it to the
 			 * AutoMoDeFiniStateMachine in construction.
-			 * Strips the different transitions and calls HandleTransition for their creation.
+			 * Calls HandleTransition for the creation of the transitions leaving the state.
 			 */
-			void HandleState(AutoMoDeFiniteStateMachine* c_fsm, std::vector<std::string>& vec_fsm_state_config);
-			void HandleGroup(AutoMoDeFiniteStateMachine* c_fsm, std::vector<std::string>& vec_fsm_state_config);
+			void HandleState(AutoMoDeFiniteStateMachine* c_fsm, const AutoMoDeFsmConfig::SState& s_state, const UInt32& un_state_index);
 
 			/**
-			 * Creates a AutoMoDeCondition from a transition configuration and add it to the
-			 * AutoMoDeFiniStateMachine in construction.
+			 * Creates a AutoMoDeCondition from a transition configuration, along with its canonical form.
 			 */
-			void HandleTransition(std::vector<std::string>& vec_fsm_transition_config,
-									const UInt32& un_initial_state_index, const UInt32& un_condition_index);
+			AutoMoDeCondition* HandleTransition(const AutoMoDeFsmConfig::STransition& s_transition,
+									const UInt32& un_initial_state_index, const UInt32& un_condition_index, std::string& str_canonical_form);
 
 			/**
-			 * Creates a list containing the indexes of the behaviours reachable from a given state.
-			 * Added for compatibility with irace interdependent parameters. 
+			 * Orders the transitions of a state by their canonical form.
 			 */
-			const std::vector<UInt32> GetPossibleDestinationBehaviour(const UInt32& un_initial_state_index);
+			static bool CompareTransitions(const std::pair<std::string, AutoMoDeCondition*>& c_first, const std::pair<std::string, AutoMoDeCondition*>& c_second);
 
 			UInt32 m_unNumberStates;
-			UInt32 m_unNumberGroups;
-			
-			UInt32 unRobotStartId;
-
-			UInt8 unGroupId;
-			UInt8 unGroupRobots; 
-
 
 			AutoMoDeFiniteStateMachine* cFiniteStateMachine;
 
+			std::string m_strCanonicalForm;
+
 	};
 }
 
@@ -0,0 +1,298 @@
+/*
+ * @file <src/core/AutoMoDeFsmConfig.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeFsmConfig.h"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace argos {
+
+	/* Largest index of a group, state or transition. */
+	static const UInt32 MAX_INDEX = 65535;
+
+	/* Largest identifier of a robot in a --gids<g> list. */
+	static const UInt32 MAX_ROBOT_ID = 1048575;
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Reads the decimal number starting at pch_current, if any, and moves pch_current after it.
+	 */
+	static bool ReadIndex(const char*& pch_current, const char* pch_end, UInt32& un_index) {
+		const char* pchStart = pch_current;
+		un_index = 0;
+		while (pch_current < pch_end && isdigit(*pch_current)) {
+			un_index = un_index * 10 + (*pch_current - '0');
+			if (un_index > MAX_INDEX) {
+				THROW_ARGOSEXCEPTION("Index too large in " << std::string(pchStart, pch_end));
+			}
+			++pch_current;
+		}
+		return pch_current != pchStart;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	/*
+	 * Reads a list of robot identifiers and ranges of identifiers, such as 0,4,10-15.
+	 */
+	static void ReadRobotIds(const char* pch_value, size_t un_value_length, std::vector<UInt32>& vec_robot_ids) {
+		std::string strList(pch_value, un_value_length);
+		const char* pchCurrent = pch_value;
+		const char* pchEnd = pch_value + un_value_length;
+		while (pchCurrent < pchEnd) {
+			UInt32 unFirst = 0;
+			UInt32 unLast = 0;
+			const char* pchStart = pchCurrent;
+			while (pchCurrent < pchEnd && isdigit(*pchCurrent) && unFirst <= MAX_ROBOT_ID) {
+				unFirst = unFirst * 10 + (*pchCurrent - '0');
+				++pchCurrent;
+			}
+			if (pchCurrent == pchStart) {
+				THROW_ARGOSEXCEPTION("Invalid list of robots " << strList);
+			}
+			unLast = unFirst;
+			if (pchCurrent < pchEnd && *pchCurrent == '-') {
+				++pchCurrent;
+				pchStart = pchCurrent;
+				unLast = 0;
+				while (pchCurrent < pchEnd && isdigit(*pchCurrent) && unLast <= MAX_ROBOT_ID) {
+					unLast = unLast * 10 + (*pchCurrent - '0');
+					++pchCurrent;
+				}
+				if (pchCurrent == pchStart || unLast < unFirst) {
+					THROW_ARGOSEXCEPTION("Invalid list of robots " << strList);
+				}
+			}
+			if (unLast > MAX_ROBOT_ID) {
+				THROW_ARGOSEXCEPTION("Robot identifier too large in " << strList);
+			}
+			for (UInt32 i = unFirst; i <= unLast; ++i) {
+				vec_robot_ids.push_back(i);
+			}
+			if (pchCurrent < pchEnd) {
+				if (*pchCurrent != ',') {
+					THROW_ARGOSEXCEPTION("Invalid list of robots " << strList);
+				}
+				++pchCurrent;
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmConfig::AutoMoDeFsmConfig() :
+		m_bHasNumberGroups(false),
+		m_unNumberGroups(0),
+		m_eGroupAssignment(ASSIGNMENT_CONTIGUOUS) {}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmConfig::Parse(const std::string& str_config) {
+		const char* pchCurrent = str_config.c_str();
+		const char* pchKey = NULL;
+		size_t unKeyLength = 0;
+		while (*pchCurrent != '\0') {
+			while (isspace(*pchCurrent)) {
+				++pchCurrent;
+			}
+			if (*pchCurrent == '\0') {
+				break;
+			}
+			const char* pchToken = pchCurrent;
+			while (*pchCurrent != '\0' && !isspace(*pchCurrent)) {
+				++pchCurrent;
+			}
+			bool bIsKey = (pchCurrent - pchToken > 2 && pchToken[0] == '-' && pchToken[1] == '-');
+			if (pchKey != NULL && !bIsKey) {
+				// The token is the value of the previous key.
+				HandleKey(pchKey, unKeyLength, pchToken, pchCurrent - pchToken);
+				pchKey = NULL;
+			} else if (bIsKey) {
+				pchKey = pchToken;
+				unKeyLength = pchCurrent - pchToken;
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmConfig::HandleKey(const char* pch_key, size_t un_key_length, const char* pch_value, size_t un_value_length) {
+		const char* pchCurrent = pch_key + 2;
+		const char* pchEnd = pch_key + un_key_length;
+
+		// A key is: --<name>[<first index>[x<second index>]][_<group>]
+		const char* pchName = pchCurrent;
+		while (pchCurrent < pchEnd && islower(*pchCurrent)) {
+			++pchCurrent;
+		}
+		std::string strName(pchName, pchCurrent);
+		UInt32 unFirst = 0;
+		UInt32 unSecond = 0;
+		UInt32 unGroup = 0;
+		bool bHasFirst = ReadIndex(pchCurrent, pchEnd, unFirst);
+		bool bHasSecond = false;
+		bool bHasGroup = false;
+		if (bHasFirst && pchCurrent < pchEnd && *pchCurrent == 'x') {
+			++pchCurrent;
+			bHasSecond = ReadIndex(pchCurrent, pchEnd, unSecond);
+			if (!bHasSecond) {
+				return;
+			}
+		}
+		if (pchCurrent < pchEnd && *pchCurrent == '_') {
+			++pchCurrent;
+			bHasGroup = ReadIndex(pchCurrent, pchEnd, unGroup);
+			if (!bHasGroup) {
+				return;
+			}
+		}
+		if (pchCurrent != pchEnd || strName.empty()) {
+			return;
+		}
+
+		// Values end with a space or the end of the string, where atoi and strtod stop.
+		UInt32 unValue = (UInt32) atoi(pch_value);
+		AutoMoDeParameters::EParameter eParameter;
+		if (!bHasGroup) {
+			if (strName == "ngroups" && !bHasFirst) {
+				m_bHasNumberGroups = true;
+				m_unNumberGroups = unValue;
+			} else if (strName == "assign" && !bHasFirst) {
+				std::string strAssignment(pch_value, un_value_length);
+				if (strAssignment == "contiguous") {
+					m_eGroupAssignment = ASSIGNMENT_CONTIGUOUS;
+				} else if (strAssignment == "interleaved") {
+					m_eGroupAssignment = ASSIGNMENT_INTERLEAVED;
+				} else {
+					THROW_ARGOSEXCEPTION("Unknown group assignment " << strAssignment);
+				}
+			} else if (strName == "g" && bHasFirst && !bHasSecond) {
+				SGroup& sGroup = GetGroup(unFirst);
+				if (!sGroup.HasSize) {
+					sGroup.HasSize = true;
+					sGroup.Size = unValue;
+				}
+			} else if (strName == "gids" && bHasFirst && !bHasSecond) {
+				SGroup& sGroup = GetGroup(unFirst);
+				if (!sGroup.HasRobotIds) {
+					sGroup.HasRobotIds = true;
+					ReadRobotIds(pch_value, un_value_length, sGroup.RobotIds);
+				}
+			}
+			return;
+		}
+
+		if (!bHasFirst) {
+			if (strName == "nstates") {
+				SGroup& sGroup = GetGroup(unGroup);
+				if (!sGroup.HasNumberStates) {
+					sGroup.HasNumberStates = true;
+					sGroup.NumberStates = unValue;
+				}
+			}
+			return;
+		}
+
+		if (!bHasSecond) {
+			SState& sState = GetState(unGroup, unFirst);
+			if (strName == "s") {
+				if (!sState.HasBehaviour) {
+					sState.HasBehaviour = true;
+					sState.Behaviour = unValue;
+				}
+			} else if (strName == "n") {
+				sState.NumberTransitions = unValue;
+			} else if (AutoMoDeParameters::FindParameter(strName, eParameter)) {
+				sState.Parameters.Set(eParameter, strtod(pch_value, NULL));
+			}
+			return;
+		}
+
+		STransition& sTransition = GetTransition(unGroup, unFirst, unSecond);
+		if (strName == "n") {
+			if (!sTransition.HasDestination) {
+				sTransition.HasDestination = true;
+				sTransition.Destination = unValue;
+			}
+		} else if (strName == "c") {
+			if (!sTransition.HasCondition) {
+				sTransition.HasCondition = true;
+				sTransition.Condition = unValue;
+			}
+		} else if (AutoMoDeParameters::FindParameter(strName, eParameter)) {
+			sTransition.Parameters.Set(eParameter, strtod(pch_value, NULL));
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmConfig::SGroup& AutoMoDeFsmConfig::GetGroup(UInt32 un_group) {
+		if (un_group >= m_vecGroups.size()) {
+			m_vecGroups.resize(un_group + 1);
+		}
+		return m_vecGroups[un_group];
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmConfig::SState& AutoMoDeFsmConfig::GetState(UInt32 un_group, UInt32 un_state) {
+		std::vector<SState>& vecStates = GetGroup(un_group).States;
+		if (un_state >= vecStates.size()) {
+			vecStates.resize(un_state + 1);
+		}
+		return vecStates[un_state];
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmConfig::STransition& AutoMoDeFsmConfig::GetTransition(UInt32 un_group, UInt32 un_state, UInt32 un_transition) {
+		std::vector<STransition>& vecTransitions = GetState(un_group, un_state).Transitions;
+		if (un_transition >= vecTransitions.size()) {
+			vecTransitions.resize(un_transition + 1);
+		}
+		return vecTransitions[un_transition];
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeFsmConfig::HasNumberGroups() const {
+		return m_bHasNumberGroups;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	UInt32 AutoMoDeFsmConfig::GetNumberGroups() const {
+		return m_unNumberGroups;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmConfig::EGroupAssignment AutoMoDeFsmConfig::GetGroupAssignment() const {
+		return m_eGroupAssignment;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const std::vector<AutoMoDeFsmConfig::SGroup>& AutoMoDeFsmConfig::GetGroups() const {
+		return m_vecGroups;
+	}
+}
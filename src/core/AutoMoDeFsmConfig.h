@@ -0,0 +1,149 @@
+/*
+ * @file <src/core/AutoMoDeFsmConfig.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class holds a parsed finite state machine configuration:
+ * 				the groups of the swarm, and for each group its states with
+ * 				their parameters and transitions. The configuration string is
+ * 				read in a single pass, each key being filed directly at its
+ * 				place in this structure.
+ */
+
+#ifndef AUTOMODE_FSM_CONFIG_H
+#define AUTOMODE_FSM_CONFIG_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+
+#include "../modules/AutoMoDeParameters.h"
+
+#include <string>
+#include <vector>
+
+namespace argos {
+	class AutoMoDeFsmConfig {
+		public:
+			/*
+			 * How the robots are split among the groups (--assign).
+			 * @see AutoMoDeGroupAssignment
+			 */
+			enum EGroupAssignment {
+				ASSIGNMENT_CONTIGUOUS,
+				ASSIGNMENT_INTERLEAVED
+			};
+
+			/*
+			 * Transition k of state j: --n<j>x<k>_<g> (destination, among the other states),
+			 * --c<j>x<k>_<g> (condition) and the parameters of the condition (--p<j>x<k>_<g>, ...).
+			 */
+			struct STransition {
+				bool HasDestination;
+				UInt32 Destination;
+				bool HasCondition;
+				UInt32 Condition;
+				AutoMoDeParameters Parameters;
+
+				STransition() :
+					HasDestination(false),
+					Destination(0),
+					HasCondition(false),
+					Condition(0) {}
+			};
+
+			/*
+			 * State j: --s<j>_<g> (behaviour), --n<j>_<g> (number of transitions) and the
+			 * parameters of the behaviour (--rwm<j>_<g>, ...).
+			 */
+			struct SState {
+				bool HasBehaviour;
+				UInt32 Behaviour;
+				UInt32 NumberTransitions;
+				AutoMoDeParameters Parameters;
+				std::vector<STransition> Transitions;
+
+				SState() :
+					HasBehaviour(false),
+					Behaviour(0),
+					NumberTransitions(0) {}
+			};
+
+			/*
+			 * Group g: --g<g> (number of robots), --gids<g> (identifiers of its robots, as
+			 * a comma-separated list of identifiers and ranges, e.g. 0,4,10-15) and
+			 * --nstates_<g> (number of states).
+			 */
+			struct SGroup {
+				bool HasSize;
+				UInt32 Size;
+				bool HasRobotIds;
+				std::vector<UInt32> RobotIds;
+				bool HasNumberStates;
+				UInt32 NumberStates;
+				std::vector<SState> States;
+
+				SGroup() :
+					HasSize(false),
+					Size(0),
+					HasRobotIds(false),
+					HasNumberStates(false),
+					NumberStates(0) {}
+			};
+
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeFsmConfig();
+
+			/*
+			 * Parses a configuration, swarm-wide or restricted to one group.
+			 * Keys that are not part of the grammar, and parameters that no module
+			 * reads, are ignored.
+			 */
+			void Parse(const std::string& str_config);
+
+			/*
+			 * Returns whether --ngroups was given, and its value.
+			 */
+			bool HasNumberGroups() const;
+			UInt32 GetNumberGroups() const;
+
+			/*
+			 * Returns the value of --assign: contiguous (default) or interleaved.
+			 */
+			EGroupAssignment GetGroupAssignment() const;
+
+			/*
+			 * Returns the groups, indexed by their identifier. Groups that do not appear in
+			 * the configuration are left empty.
+			 */
+			const std::vector<SGroup>& GetGroups() const;
+
+		private:
+			/*
+			 * Returns the group, state or transition, creating it if needed.
+			 */
+			SGroup& GetGroup(UInt32 un_group);
+			SState& GetState(UInt32 un_group, UInt32 un_state);
+			STransition& GetTransition(UInt32 un_group, UInt32 un_state, UInt32 un_transition);
+
+			/*
+			 * Files the pair (key, value) in the structure.
+			 */
+			void HandleKey(const char* pch_key, size_t un_key_length, const char* pch_value, size_t un_value_length);
+
+			/*
+			 * Compiled configurations are loaded without parsing.
+			 */
+			friend class AutoMoDeFsmBinary;
+
+			bool m_bHasNumberGroups;
+			UInt32 m_unNumberGroups;
+			EGroupAssignment m_eGroupAssignment;
+			std::vector<SGroup> m_vecGroups;
+	};
+}
+
+#endif
@@ -46,14 +46,14 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeFsmHistory::AddTimeStep(UInt32 un_time_step, AutoMoDeBehaviour* pc_current_state, std::map<AutoMoDeCondition*, bool> map_transition_status) {
+	void AutoMoDeFsmHistory::AddTimeStep(UInt32 un_time_step, AutoMoDeBehaviour* pc_current_state, const SCheckedCondition* ps_checked_conditions, UInt32 un_number_checked_conditions) {
 		std::stringstream ssInput;
 		ssInput << "--t " << un_time_step << " ";
 		ssInput << "--s" << pc_current_state->GetIndex() << " " << pc_current_state->GetIdentifier() << " ";
 
-		std::map<AutoMoDeCondition*, bool>::iterator it;
-		for (it = map_transition_status.begin(); it != map_transition_status.end(); ++it) {
-			ssInput << "--c" << (it->first)->GetIndex() << " "  << (it->first)->GetIdentifier() << " " << (it->second) << " ";
+		for (UInt32 i = 0; i < un_number_checked_conditions; ++i) {
+			const SCheckedCondition& sChecked = ps_checked_conditions[i];
+			ssInput << "--c" << sChecked.Condition->GetIndex() << " "  << sChecked.Condition->GetIdentifier() << " " << sChecked.Fulfilled << " ";
 		}
 
 		m_ofHistoryFile << ssInput.str() << std::endl;
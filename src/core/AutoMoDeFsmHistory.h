@@ -23,7 +23,6 @@
 #include <fstream>
 #include <sstream>
 #include <string>
-#include <map>
 
 namespace argos {
 	class AutoMoDeFsmHistory {
@@ -44,9 +43,19 @@ namespace argos {
 			virtual ~AutoMoDeFsmHistory();
 
 			/*
-			 *
+			 * A condition checked during a time step, and whether it was fulfilled.
+			 */
+			struct SCheckedCondition {
+				AutoMoDeCondition* Condition;
+				bool Fulfilled;
+			};
+
+			/*
+			 * Records the state of a time step and the conditions checked during it, in the
+			 * order of ps_checked_conditions: the order of the transitions of the state in the
+			 * configuration, which does not depend on where the conditions lie in memory.
 			 */
-			void AddTimeStep(UInt32 un_time_step, AutoMoDeBehaviour* pc_current_state, std::map<AutoMoDeCondition*, bool> map_transition_status);
+			void AddTimeStep(UInt32 un_time_step, AutoMoDeBehaviour* pc_current_state, const SCheckedCondition* ps_checked_conditions, UInt32 un_number_checked_conditions);
 
 			/*
 			 *
@@ -0,0 +1,99 @@
+/*
+ * @file <src/core/AutoMoDeFsmTemplates.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeFsmTemplates.h"
+
+#include <new>
+
+namespace argos {
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmTemplates::AutoMoDeFsmTemplates(const std::string& str_fsm_config) {
+		try {
+			m_cFsmConfig.Parse(str_fsm_config);
+			m_cGroupAssignment.Init(m_cFsmConfig);
+		} catch (CARGoSException& ex) {
+			THROW_ARGOSEXCEPTION_NESTED("Could not create the Finite State Machine: Error while parsing.", ex);
+		}
+		m_vecBuilders.resize(m_cFsmConfig.GetGroups().size(), NULL);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmTemplates::AutoMoDeFsmTemplates(const AutoMoDeFsmConfig& c_fsm_config) :
+		m_cFsmConfig(c_fsm_config) {
+		m_cGroupAssignment.Init(m_cFsmConfig);
+		m_vecBuilders.resize(m_cFsmConfig.GetGroups().size(), NULL);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmTemplates::~AutoMoDeFsmTemplates() {
+		for (UInt32 i = 0; i < m_vecBuilders.size(); ++i) {
+			delete m_vecBuilders.at(i);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const AutoMoDeFiniteStateMachine* AutoMoDeFsmTemplates::GetTemplate(UInt32 un_group) {
+		return GetBuilder(un_group)->GetFiniteStateMachine();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFiniteStateMachine* AutoMoDeFsmTemplates::CreateFiniteStateMachine(UInt32 un_robot_id) {
+		return new AutoMoDeFiniteStateMachine(GetTemplate(GetGroupOfRobot(un_robot_id)));
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFiniteStateMachine* AutoMoDeFsmTemplates::CreateFiniteStateMachine(UInt32 un_robot_id, AutoMoDeArena& c_arena) {
+		const AutoMoDeFiniteStateMachine* pcTemplate = GetTemplate(GetGroupOfRobot(un_robot_id));
+		// The copies of different robots, which may be stepped by different threads, do not share cache lines.
+		void* pMemory = c_arena.Allocate(sizeof(AutoMoDeFiniteStateMachine), AutoMoDeArena::CACHE_LINE_SIZE);
+		if (pcTemplate->IsShareable()) {
+			return new (pMemory) AutoMoDeFiniteStateMachine(pcTemplate, AutoMoDeFiniteStateMachine::INSTANCE);
+		}
+		return new (pMemory) AutoMoDeFiniteStateMachine(pcTemplate, c_arena);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	SAutoMoDeDigest AutoMoDeFsmTemplates::GetStructuralHash(UInt32 un_group) {
+		return GetBuilder(un_group)->GetStructuralHash();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmBuilder* AutoMoDeFsmTemplates::GetBuilder(UInt32 un_group) {
+		if (un_group >= m_vecBuilders.size() || !m_cFsmConfig.GetGroups().at(un_group).HasNumberStates) {
+			THROW_ARGOSEXCEPTION("Could not find --nstates_" << un_group << " in FSM configuration.");
+		}
+		if (m_vecBuilders.at(un_group) == NULL) {
+			AutoMoDeFsmBuilder* pcBuilder = new AutoMoDeFsmBuilder();
+			try {
+				pcBuilder->BuildFiniteStateMachine(m_cFsmConfig.GetGroups().at(un_group));
+			} catch (std::exception& ex) {
+				delete pcBuilder;
+				throw;
+			}
+			m_vecBuilders.at(un_group) = pcBuilder;
+		}
+		return m_vecBuilders.at(un_group);
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ * @file <src/core/AutoMoDeFsmTemplates.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class holds the finite state machines of the groups of a
+ * 				swarm-wide configuration. The configuration is parsed once, the
+ * 				finite state machine of each group is built once, the first time
+ * 				a robot of the group needs it, and the robots are given copies
+ * 				of it.
+ */
+
+#ifndef AUTOMODE_FSM_TEMPLATES_H
+#define AUTOMODE_FSM_TEMPLATES_H
+
+#include "AutoMoDeArena.h"
+#include "AutoMoDeFiniteStateMachine.h"
+#include "AutoMoDeFsmBuilder.h"
+#include "AutoMoDeFsmConfig.h"
+#include "AutoMoDeGroupAssignment.h"
+#include "AutoMoDeHash.h"
+
+#include <string>
+#include <vector>
+
+namespace argos {
+	class AutoMoDeFsmTemplates {
+		public:
+			/*
+			 * Class constructor. Parses the swarm-wide configuration and assigns the robots
+			 * to the groups.
+			 */
+			AutoMoDeFsmTemplates(const std::string& str_fsm_config);
+
+			/*
+			 * Class constructor. Assigns the robots to the groups of an already parsed
+			 * (or loaded) configuration.
+			 */
+			AutoMoDeFsmTemplates(const AutoMoDeFsmConfig& c_fsm_config);
+
+			/*
+			 * Class destructor. Deletes the templates, but not the copies given to the robots.
+			 */
+			virtual ~AutoMoDeFsmTemplates();
+
+			/*
+			 * Returns the group of a robot.
+			 * @see AutoMoDeGroupAssignment
+			 */
+			inline UInt32 GetGroupOfRobot(UInt32 un_robot_id) const {
+				return m_cGroupAssignment.GetGroup(un_robot_id);
+			}
+
+			/*
+			 * Returns the finite state machine of a group, building it if needed.
+			 */
+			const AutoMoDeFiniteStateMachine* GetTemplate(UInt32 un_group);
+
+			/*
+			 * Returns a new copy of the finite state machine of the group of a robot.
+			 * The caller owns the copy.
+			 */
+			AutoMoDeFiniteStateMachine* CreateFiniteStateMachine(UInt32 un_robot_id);
+
+			/*
+			 * Same as above, placed in an arena. When the template is shareable, the copy is
+			 * an instance of it, which must not be stepped once the templates are destroyed;
+			 * otherwise its modules are placed in the arena too. Each copy starts on a new cache
+			 * line. The caller destroys the copy (without deleting it) before clearing the arena.
+			 * @see AutoMoDeFiniteStateMachine::IsShareable()
+			 */
+			AutoMoDeFiniteStateMachine* CreateFiniteStateMachine(UInt32 un_robot_id, AutoMoDeArena& c_arena);
+
+			/*
+			 * Returns the structural hash of the finite state machine of a group, building it if needed.
+			 * @see AutoMoDeFsmBuilder::GetStructuralHash()
+			 */
+			SAutoMoDeDigest GetStructuralHash(UInt32 un_group);
+
+		private:
+			/*
+			 * Copying would share the templates.
+			 */
+			AutoMoDeFsmTemplates(const AutoMoDeFsmTemplates&);
+			AutoMoDeFsmTemplates& operator=(const AutoMoDeFsmTemplates&);
+
+			/*
+			 * Returns the builder holding the finite state machine of a group, building it if needed.
+			 */
+			AutoMoDeFsmBuilder* GetBuilder(UInt32 un_group);
+
+			AutoMoDeFsmConfig m_cFsmConfig;
+
+			AutoMoDeGroupAssignment m_cGroupAssignment;
+
+			/*
+			 * Builders of the finite state machines of the groups, NULL until built.
+			 */
+			std::vector<AutoMoDeFsmBuilder*> m_vecBuilders;
+	};
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * @file <src/core/AutoMoDeFsmValidator.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeFsmValidator.h"
+#include "AutoMoDeGroupAssignment.h"
+
+#include <sstream>
+
+namespace argos {
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeFsmValidator::AutoMoDeFsmValidator() {}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeFsmValidator::Validate(const AutoMoDeFsmConfig& c_fsm_config) {
+		m_vecErrors.clear();
+
+		try {
+			AutoMoDeGroupAssignment cGroupAssignment;
+			cGroupAssignment.Init(c_fsm_config);
+		} catch (CARGoSException& ex) {
+			m_vecErrors.push_back(ex.what());
+		}
+
+		/*
+		 * A group needs its states if robots can belong to it: robots are given to it by
+		 * --g<i> or --gids<i>, they are interleaved over all the groups, or no group is
+		 * given robots, in which case they all belong to the first one.
+		 */
+		const std::vector<AutoMoDeFsmConfig::SGroup>& vecGroups = c_fsm_config.GetGroups();
+		bool bInterleaved = (c_fsm_config.GetGroupAssignment() == AutoMoDeFsmConfig::ASSIGNMENT_INTERLEAVED);
+		bool bAnyGroupGivenRobots = false;
+		for (UInt32 i = 0; i < vecGroups.size(); ++i) {
+			bAnyGroupGivenRobots = bAnyGroupGivenRobots || vecGroups.at(i).HasSize || vecGroups.at(i).HasRobotIds;
+		}
+		UInt32 unNumberGroups = vecGroups.size();
+		if (c_fsm_config.HasNumberGroups() && c_fsm_config.GetNumberGroups() > unNumberGroups) {
+			unNumberGroups = c_fsm_config.GetNumberGroups();
+		}
+		if (unNumberGroups == 0) {
+			unNumberGroups = 1;
+		}
+		for (UInt32 i = 0; i < unNumberGroups; ++i) {
+			if (i < vecGroups.size() && vecGroups.at(i).HasNumberStates) {
+				ValidateGroup(vecGroups.at(i), i);
+				continue;
+			}
+			bool bHasRobots = bInterleaved || (i == 0 && !bAnyGroupGivenRobots);
+			if (i < vecGroups.size()) {
+				const AutoMoDeFsmConfig::SGroup& sGroup = vecGroups.at(i);
+				bHasRobots = bHasRobots || (sGroup.HasSize && sGroup.Size > 0) || (sGroup.HasRobotIds && !sGroup.RobotIds.empty());
+			}
+			if (bHasRobots) {
+				std::ostringstream ossError;
+				ossError << "--nstates_" << i << ": missing, group " << i << " has robots";
+				m_vecErrors.push_back(ossError.str());
+			}
+		}
+
+		return m_vecErrors.empty();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const std::vector<std::string>& AutoMoDeFsmValidator::GetErrors() const {
+		return m_vecErrors;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	std::string AutoMoDeFsmValidator::GetReport() const {
+		std::string strReport;
+		for (UInt32 i = 0; i < m_vecErrors.size(); ++i) {
+			strReport += (i > 0 ? "; " : "") + m_vecErrors.at(i);
+		}
+		return strReport;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmValidator::ValidateGroup(const AutoMoDeFsmConfig::SGroup& s_group, UInt32 un_group) {
+		if (s_group.NumberStates == 0) {
+			std::ostringstream ossError;
+			ossError << "--nstates_" << un_group << ": no state";
+			m_vecErrors.push_back(ossError.str());
+			return;
+		}
+		// The states after the last one are ignored, as the builder does.
+		for (UInt32 j = 0; j < s_group.NumberStates; ++j) {
+			if (j >= s_group.States.size() || !s_group.States.at(j).HasBehaviour) {
+				std::ostringstream ossError;
+				ossError << "--s" << j << "_" << un_group << ": missing, group " << un_group << " has " << s_group.NumberStates << " states";
+				m_vecErrors.push_back(ossError.str());
+			} else {
+				ValidateState(s_group.States.at(j), un_group, j, s_group.NumberStates);
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmValidator::ValidateState(const AutoMoDeFsmConfig::SState& s_state, UInt32 un_group, UInt32 un_state, UInt32 un_number_states) {
+		std::ostringstream ossSuffix;
+		ossSuffix << un_state << "_" << un_group;
+
+		const SAutoMoDeModuleDescription* psDescription = GetBehaviourDescription(s_state.Behaviour);
+		if (psDescription == NULL) {
+			std::ostringstream ossError;
+			ossError << "--s" << ossSuffix.str() << ": unknown behaviour " << s_state.Behaviour;
+			m_vecErrors.push_back(ossError.str());
+		} else {
+			ValidateParameters(psDescription, s_state.Parameters, ossSuffix.str());
+		}
+
+		if (s_state.NumberTransitions > AutoMoDeFiniteStateMachine::MAX_OUTGOING_TRANSITIONS) {
+			std::ostringstream ossError;
+			ossError << "--n" << ossSuffix.str() << ": " << s_state.NumberTransitions << " transitions, at most "
+				<< AutoMoDeFiniteStateMachine::MAX_OUTGOING_TRANSITIONS;
+			m_vecErrors.push_back(ossError.str());
+		}
+		// Transitions are only described up to the last one given, the others are all missing.
+		if (s_state.NumberTransitions > s_state.Transitions.size()) {
+			std::ostringstream ossError;
+			ossError << "--n" << ossSuffix.str() << ": " << s_state.NumberTransitions << " transitions, but only "
+				<< s_state.Transitions.size() << " described";
+			m_vecErrors.push_back(ossError.str());
+		}
+		for (UInt32 k = 0; k < s_state.NumberTransitions && k < s_state.Transitions.size(); ++k) {
+			ValidateTransition(s_state.Transitions.at(k), un_group, un_state, k, un_number_states);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmValidator::ValidateTransition(const AutoMoDeFsmConfig::STransition& s_transition, UInt32 un_group, UInt32 un_state, UInt32 un_transition, UInt32 un_number_states) {
+		std::ostringstream ossSuffix;
+		ossSuffix << un_state << "x" << un_transition << "_" << un_group;
+
+		// The destination is given among the states other than the initial one.
+		if (!s_transition.HasDestination) {
+			m_vecErrors.push_back("--n" + ossSuffix.str() + ": missing");
+		} else if (s_transition.Destination >= un_number_states - 1) {
+			std::ostringstream ossError;
+			ossError << "--n" << ossSuffix.str() << ": destination " << s_transition.Destination << " out of range, ";
+			if (un_number_states > 1) {
+				ossError << "the other states are numbered from 0 to " << un_number_states - 2;
+			} else {
+				ossError << "there is no other state";
+			}
+			m_vecErrors.push_back(ossError.str());
+		}
+
+		if (!s_transition.HasCondition) {
+			m_vecErrors.push_back("--c" + ossSuffix.str() + ": missing");
+		} else {
+			const SAutoMoDeModuleDescription* psDescription = GetConditionDescription(s_transition.Condition);
+			if (psDescription == NULL) {
+				std::ostringstream ossError;
+				ossError << "--c" << ossSuffix.str() << ": unknown condition " << s_transition.Condition;
+				m_vecErrors.push_back(ossError.str());
+			} else {
+				ValidateParameters(psDescription, s_transition.Parameters, ossSuffix.str());
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeFsmValidator::ValidateParameters(const SAutoMoDeModuleDescription* ps_description, const AutoMoDeParameters& c_parameters, const std::string& str_suffix) {
+		for (UInt32 i = 0; i < ps_description->NumberParameters; ++i) {
+			AutoMoDeParameters::EParameter eParameter = ps_description->Parameters[i].Parameter;
+			if (!c_parameters.Has(eParameter)) {
+				m_vecErrors.push_back(std::string("--") + AutoMoDeParameters::GetName(eParameter) + str_suffix + ": missing, read by " + ps_description->Label);
+			}
+		}
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * @file <src/core/AutoMoDeFsmValidator.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class checks a parsed finite state machine configuration
+ * 				against the module catalogue, without building any module: each
+ * 				group robots can belong to must describe all its states, with
+ * 				known behaviours and conditions, the parameters they read, and
+ * 				at most AutoMoDeFiniteStateMachine::MAX_OUTGOING_TRANSITIONS
+ * 				transitions per state, leading to existing states. All the problems found
+ * 				are reported, each with the key it concerns.
+ */
+
+#ifndef AUTOMODE_FSM_VALIDATOR_H
+#define AUTOMODE_FSM_VALIDATOR_H
+
+#include "AutoMoDeFiniteStateMachine.h"
+#include "AutoMoDeFsmConfig.h"
+#include "AutoMoDeModuleCatalogue.h"
+
+#include <string>
+#include <vector>
+
+namespace argos {
+	class AutoMoDeFsmValidator {
+		public:
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeFsmValidator();
+
+			/*
+			 * Checks a configuration. Returns whether it is valid.
+			 */
+			bool Validate(const AutoMoDeFsmConfig& c_fsm_config);
+
+			/*
+			 * Returns the problems found by the last call to Validate().
+			 */
+			const std::vector<std::string>& GetErrors() const;
+
+			/*
+			 * Returns the problems found by the last call to Validate(), separated by "; ".
+			 */
+			std::string GetReport() const;
+
+		private:
+			/*
+			 * Checks the states of group un_group.
+			 */
+			void ValidateGroup(const AutoMoDeFsmConfig::SGroup& s_group, UInt32 un_group);
+
+			/*
+			 * Checks state un_state of group un_group, and its transitions.
+			 */
+			void ValidateState(const AutoMoDeFsmConfig::SState& s_state, UInt32 un_group, UInt32 un_state, UInt32 un_number_states);
+
+			/*
+			 * Checks transition un_transition of state un_state of group un_group.
+			 */
+			void ValidateTransition(const AutoMoDeFsmConfig::STransition& s_transition, UInt32 un_group, UInt32 un_state, UInt32 un_transition, UInt32 un_number_states);
+
+			/*
+			 * Checks that the parameters read by a module are given. The key of a parameter
+			 * is its name followed by str_suffix.
+			 */
+			void ValidateParameters(const SAutoMoDeModuleDescription* ps_description, const AutoMoDeParameters& c_parameters, const std::string& str_suffix);
+
+			std::vector<std::string> m_vecErrors;
+	};
+}
+
+#endif
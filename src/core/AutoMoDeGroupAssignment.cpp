@@ -0,0 +1,87 @@
+/*
+ * @file <src/core/AutoMoDeGroupAssignment.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeGroupAssignment.h"
+
+namespace argos {
+
+	/* Largest number of robots split contiguously among the groups. */
+	static const UInt32 MAX_ROBOTS = 1048576;
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeGroupAssignment::AutoMoDeGroupAssignment() :
+		m_bCyclic(false) {}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeGroupAssignment::Init(const AutoMoDeFsmConfig& c_fsm_config) {
+		const std::vector<AutoMoDeFsmConfig::SGroup>& vecGroups = c_fsm_config.GetGroups();
+		UInt32 unNumberGroups = (c_fsm_config.HasNumberGroups() ? c_fsm_config.GetNumberGroups() : 0);
+		m_vecGroups.clear();
+		m_bCyclic = false;
+		if (vecGroups.size() > 0xFFFF || unNumberGroups > 0xFFFF) {
+			THROW_ARGOSEXCEPTION("Too many groups: more than " << 0xFFFF);
+		}
+
+		if (c_fsm_config.GetGroupAssignment() == AutoMoDeFsmConfig::ASSIGNMENT_INTERLEAVED) {
+			if (unNumberGroups == 0) {
+				THROW_ARGOSEXCEPTION("Interleaved assignment of the robots to " << unNumberGroups << " groups");
+			}
+			for (UInt32 i = 0; i < unNumberGroups; ++i) {
+				m_vecGroups.push_back(i);
+			}
+			m_bCyclic = true;
+			return;
+		}
+
+		UInt32 unDescribedGroups = 0;
+		bool bExplicit = false;
+		for (UInt32 i = 0; i < vecGroups.size(); ++i) {
+			if (vecGroups.at(i).HasSize || vecGroups.at(i).HasRobotIds) {
+				++unDescribedGroups;
+			}
+			bExplicit = bExplicit || vecGroups.at(i).HasRobotIds;
+		}
+		if (unNumberGroups != unDescribedGroups) {
+			THROW_ARGOSEXCEPTION("Mismatch between --ngroups and number of --g<i> entries");
+		}
+
+		if (bExplicit) {
+			// Robots listed nowhere are marked, then sent to the first group.
+			const UInt16 unUnassigned = 0xFFFF;
+			for (UInt32 i = 0; i < vecGroups.size(); ++i) {
+				const std::vector<UInt32>& vecRobotIds = vecGroups.at(i).RobotIds;
+				for (UInt32 j = 0; j < vecRobotIds.size(); ++j) {
+					if (vecRobotIds.at(j) >= m_vecGroups.size()) {
+						m_vecGroups.resize(vecRobotIds.at(j) + 1, unUnassigned);
+					}
+					if (m_vecGroups[vecRobotIds.at(j)] != unUnassigned && m_vecGroups[vecRobotIds.at(j)] != i) {
+						THROW_ARGOSEXCEPTION("Robot " << vecRobotIds.at(j) << " listed in groups " << m_vecGroups[vecRobotIds.at(j)] << " and " << i);
+					}
+					m_vecGroups[vecRobotIds.at(j)] = i;
+				}
+			}
+			for (UInt32 i = 0; i < m_vecGroups.size(); ++i) {
+				if (m_vecGroups[i] == unUnassigned) {
+					m_vecGroups[i] = 0;
+				}
+			}
+			return;
+		}
+
+		for (UInt32 i = 0; i < vecGroups.size(); ++i) {
+			if (vecGroups.at(i).Size > MAX_ROBOTS - m_vecGroups.size()) {
+				THROW_ARGOSEXCEPTION("Too many robots in the groups: more than " << MAX_ROBOTS);
+			}
+			m_vecGroups.resize(m_vecGroups.size() + vecGroups.at(i).Size, i);
+		}
+	}
+}
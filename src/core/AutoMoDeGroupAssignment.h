@@ -0,0 +1,61 @@
+/*
+ * @file <src/core/AutoMoDeGroupAssignment.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class tells the group of each robot of a heterogeneous swarm.
+ * 				It is computed once from the configuration, as a table indexed
+ * 				by the robot identifiers. The robots are split among the groups:
+ * 				- contiguously (default): group i takes the next --g<i> robots,
+ * 				  by increasing identifier;
+ * 				- by explicit lists, if a --gids<i> is given: group i takes the
+ * 				  robots of its list;
+ * 				- interleaved (--assign interleaved): robot r belongs to group
+ * 				  r modulo --ngroups.
+ * 				The robots that are not assigned belong to the first group.
+ */
+
+#ifndef AUTOMODE_GROUP_ASSIGNMENT_H
+#define AUTOMODE_GROUP_ASSIGNMENT_H
+
+#include "AutoMoDeFsmConfig.h"
+
+#include <vector>
+
+namespace argos {
+	class AutoMoDeGroupAssignment {
+		public:
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeGroupAssignment();
+
+			/*
+			 * Computes the table of a configuration. Throws if --ngroups does not match the
+			 * number of groups described, or if a robot is listed in several groups.
+			 */
+			void Init(const AutoMoDeFsmConfig& c_fsm_config);
+
+			/*
+			 * Returns the group of a robot.
+			 */
+			inline UInt32 GetGroup(UInt32 un_robot_id) const {
+				if (m_bCyclic) {
+					return m_vecGroups[un_robot_id % m_vecGroups.size()];
+				}
+				return (un_robot_id < m_vecGroups.size() ? m_vecGroups[un_robot_id] : 0);
+			}
+
+		private:
+			/*
+			 * Group of each robot, indexed by identifier. When cyclic, the table repeats itself.
+			 */
+			std::vector<UInt16> m_vecGroups;
+
+			bool m_bCyclic;
+	};
+}
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * @file <src/core/AutoMoDeHash.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeHash.h"
+
+namespace argos {
+
+	/****************************************/
+	/****************************************/
+
+	static inline UInt64 RotateLeft(UInt64 un_value, UInt8 un_shift) {
+		return (un_value << un_shift) | (un_value >> (64 - un_shift));
+	}
+
+	/****************************************/
+	/****************************************/
+
+	static inline UInt64 FinalMix(UInt64 un_value) {
+		un_value ^= un_value >> 33;
+		un_value *= 0xff51afd7ed558ccdULL;
+		un_value ^= un_value >> 33;
+		un_value *= 0xc4ceb9fe1a85ec53ULL;
+		un_value ^= un_value >> 33;
+		return un_value;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	static inline UInt64 ReadBlock(const UInt8* pun_data) {
+		UInt64 unBlock = 0;
+		for (UInt8 i = 0; i < 8; ++i) {
+			unBlock |= ((UInt64) pun_data[i]) << (8 * i);
+		}
+		return unBlock;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	std::string SAutoMoDeDigest::ToString() const {
+		std::ostringstream oss;
+		oss << std::hex << std::setfill('0') << std::setw(16) << High << std::setw(16) << Low;
+		return oss.str();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeHash::AutoMoDeHash() {}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeHash::Update(const void* pt_data, size_t un_size) {
+		m_strData.append((const char*) pt_data, un_size);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeHash::Update(const std::string& str_data) {
+		Update((UInt64) str_data.size());
+		m_strData.append(str_data);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeHash::Update(UInt64 un_data) {
+		UInt8 punBytes[8];
+		for (UInt8 i = 0; i < 8; ++i) {
+			punBytes[i] = (un_data >> (8 * i)) & 0xff;
+		}
+		Update(punBytes, 8);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeHash::Update(const SAutoMoDeDigest& s_digest) {
+		Update(s_digest.High);
+		Update(s_digest.Low);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeHash::UpdateWithFile(const std::string& str_path) {
+		std::ifstream cFile(str_path.c_str(), std::ifstream::binary);
+		if (cFile.fail()) {
+			THROW_ARGOSEXCEPTION("Error opening file \"" << str_path << "\"");
+		}
+		std::ostringstream ossContent;
+		ossContent << cFile.rdbuf();
+		Update(ossContent.str());
+	}
+
+	/****************************************/
+	/****************************************/
+
+	SAutoMoDeDigest AutoMoDeHash::GetDigest() const {
+		const UInt8* punData = (const UInt8*) m_strData.data();
+		const size_t unSize = m_strData.size();
+		const size_t unNumberBlocks = unSize / 16;
+		const UInt64 unC1 = 0x87c37b91114253d5ULL;
+		const UInt64 unC2 = 0x4cf5ad432745937fULL;
+		UInt64 unH1 = 0;
+		UInt64 unH2 = 0;
+
+		for (size_t i = 0; i < unNumberBlocks; ++i) {
+			UInt64 unK1 = ReadBlock(punData + 16 * i);
+			UInt64 unK2 = ReadBlock(punData + 16 * i + 8);
+
+			unK1 *= unC1; unK1 = RotateLeft(unK1, 31); unK1 *= unC2; unH1 ^= unK1;
+			unH1 = RotateLeft(unH1, 27); unH1 += unH2; unH1 = unH1 * 5 + 0x52dce729;
+
+			unK2 *= unC2; unK2 = RotateLeft(unK2, 33); unK2 *= unC1; unH2 ^= unK2;
+			unH2 = RotateLeft(unH2, 31); unH2 += unH1; unH2 = unH2 * 5 + 0x38495ab5;
+		}
+
+		// Remaining bytes
+		const UInt8* punTail = punData + 16 * unNumberBlocks;
+		UInt64 unK1 = 0;
+		UInt64 unK2 = 0;
+		for (size_t i = (unSize & 15); i > 8; --i) {
+			unK2 ^= ((UInt64) punTail[i - 1]) << (8 * (i - 9));
+		}
+		if ((unSize & 15) > 8) {
+			unK2 *= unC2; unK2 = RotateLeft(unK2, 33); unK2 *= unC1; unH2 ^= unK2;
+		}
+		for (size_t i = std::min<size_t>(unSize & 15, 8); i > 0; --i) {
+			unK1 ^= ((UInt64) punTail[i - 1]) << (8 * (i - 1));
+		}
+		if ((unSize & 15) > 0) {
+			unK1 *= unC1; unK1 = RotateLeft(unK1, 31); unK1 *= unC2; unH1 ^= unK1;
+		}
+
+		// Finalization
+		unH1 ^= unSize;
+		unH2 ^= unSize;
+		unH1 += unH2;
+		unH2 += unH1;
+		unH1 = FinalMix(unH1);
+		unH2 = FinalMix(unH2);
+		unH1 += unH2;
+		unH2 += unH1;
+
+		SAutoMoDeDigest sDigest;
+		sDigest.High = unH1;
+		sDigest.Low = unH2;
+		return sDigest;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	SAutoMoDeDigest AutoMoDeHash::Digest(const std::string& str_data) {
+		AutoMoDeHash cHash;
+		cHash.Update(str_data.data(), str_data.size());
+		return cHash.GetDigest();
+	}
+}
@@ -0,0 +1,104 @@
+/*
+ * @file <src/core/AutoMoDeHash.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class computes 128-bit digests (MurmurHash3, x64 variant)
+ * 				of the data fed to it. The digests are used as keys to identify
+ * 				evaluations and finite state machine configurations.
+ */
+
+#ifndef AUTOMODE_HASH_H
+#define AUTOMODE_HASH_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+
+#include <algorithm>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace argos {
+	/*
+	 * A 128-bit digest.
+	 */
+	struct SAutoMoDeDigest {
+		UInt64 High;
+		UInt64 Low;
+
+		SAutoMoDeDigest() : High(0), Low(0) {}
+
+		bool operator==(const SAutoMoDeDigest& s_other) const {
+			return High == s_other.High && Low == s_other.Low;
+		}
+
+		bool operator!=(const SAutoMoDeDigest& s_other) const {
+			return !(*this == s_other);
+		}
+
+		bool operator<(const SAutoMoDeDigest& s_other) const {
+			return High < s_other.High || (High == s_other.High && Low < s_other.Low);
+		}
+
+		/*
+		 * Returns the digest as 32 hexadecimal characters.
+		 */
+		std::string ToString() const;
+	};
+
+	class AutoMoDeHash {
+		public:
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeHash();
+
+			/*
+			 * Feeds raw bytes to the hash.
+			 */
+			void Update(const void* pt_data, size_t un_size);
+
+			/*
+			 * Feeds a string to the hash. The string is prefixed by its length, so that
+			 * successive strings cannot be confused with their concatenation.
+			 */
+			void Update(const std::string& str_data);
+
+			/*
+			 * Feeds an integer to the hash.
+			 */
+			void Update(UInt64 un_data);
+
+			/*
+			 * Feeds another digest to the hash.
+			 */
+			void Update(const SAutoMoDeDigest& s_digest);
+
+			/*
+			 * Feeds the content of a file to the hash.
+			 */
+			void UpdateWithFile(const std::string& str_path);
+
+			/*
+			 * Returns the digest of all the data fed so far.
+			 */
+			SAutoMoDeDigest GetDigest() const;
+
+			/*
+			 * Returns the digest of a string.
+			 */
+			static SAutoMoDeDigest Digest(const std::string& str_data);
+
+		private:
+			/*
+			 * The data fed so far.
+			 */
+			std::string m_strData;
+	};
+}
+
+#endif
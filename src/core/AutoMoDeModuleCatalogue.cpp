@@ -0,0 +1,96 @@
+/*
+ * @file <src/core/AutoMoDeModuleCatalogue.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeModuleCatalogue.h"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace argos {
+
+	/*
+	 * Must be kept in line with the Init() method of the modules.
+	 */
+	static const SAutoMoDeModuleDescription BEHAVIOURS[] = {
+		{0, "Exploration", 2, {{AutoMoDeParameters::RWM, PARAMETER_INTEGER}, {AutoMoDeParameters::CLE, PARAMETER_COLOR}}},
+		{1, "Stop", 1, {{AutoMoDeParameters::CLE, PARAMETER_COLOR}}},
+		{2, "Phototaxis", 0, {}},
+		{3, "AntiPhototaxis", 0, {}},
+		{4, "Attraction", 2, {{AutoMoDeParameters::ATT, PARAMETER_INTEGER}, {AutoMoDeParameters::CLE, PARAMETER_COLOR}}},
+		{5, "Repulsion", 2, {{AutoMoDeParameters::REP, PARAMETER_INTEGER}, {AutoMoDeParameters::CLE, PARAMETER_COLOR}}},
+		{8, "GoToColor", 3, {{AutoMoDeParameters::VEL, PARAMETER_REAL}, {AutoMoDeParameters::CLE, PARAMETER_COLOR}, {AutoMoDeParameters::CLR, PARAMETER_COLOR}}},
+		{9, "GoAwayColor", 3, {{AutoMoDeParameters::VEL, PARAMETER_REAL}, {AutoMoDeParameters::CLE, PARAMETER_COLOR}, {AutoMoDeParameters::CLR, PARAMETER_COLOR}}}
+	};
+
+	static const SAutoMoDeModuleDescription CONDITIONS[] = {
+		{0, "BlackFloor", 1, {{AutoMoDeParameters::P, PARAMETER_REAL}}},
+		{1, "GrayFloor", 1, {{AutoMoDeParameters::P, PARAMETER_REAL}}},
+		{2, "WhiteFloor", 1, {{AutoMoDeParameters::P, PARAMETER_REAL}}},
+		{3, "NeighborsCount", 2, {{AutoMoDeParameters::W, PARAMETER_REAL}, {AutoMoDeParameters::P, PARAMETER_INTEGER}}},
+		{4, "InvertedNeighborsCount", 2, {{AutoMoDeParameters::W, PARAMETER_REAL}, {AutoMoDeParameters::P, PARAMETER_INTEGER}}},
+		{5, "FixedProbability", 1, {{AutoMoDeParameters::P, PARAMETER_REAL}}},
+		{7, "ProbColor", 2, {{AutoMoDeParameters::L, PARAMETER_COLOR}, {AutoMoDeParameters::P, PARAMETER_REAL}}}
+	};
+
+	/* Index of the last color known by the modules. */
+	static const UInt32 LAST_COLOR = 6;
+
+	/****************************************/
+	/****************************************/
+
+	const SAutoMoDeModuleDescription* GetBehaviourDescription(UInt32 un_identifier) {
+		for (UInt32 i = 0; i < sizeof(BEHAVIOURS) / sizeof(BEHAVIOURS[0]); ++i) {
+			if (BEHAVIOURS[i].Identifier == un_identifier) {
+				return &BEHAVIOURS[i];
+			}
+		}
+		return NULL;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const SAutoMoDeModuleDescription* GetConditionDescription(UInt32 un_identifier) {
+		for (UInt32 i = 0; i < sizeof(CONDITIONS) / sizeof(CONDITIONS[0]); ++i) {
+			if (CONDITIONS[i].Identifier == un_identifier) {
+				return &CONDITIONS[i];
+			}
+		}
+		return NULL;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	std::string FormatParameterValue(EAutoMoDeParameterType e_type, Real f_value) {
+		std::ostringstream oss;
+		switch (e_type) {
+			case PARAMETER_INTEGER:
+				oss << (SInt64) f_value;
+				break;
+			case PARAMETER_COLOR: {
+				UInt32 unColor = (UInt32) f_value;
+				oss << (unColor > LAST_COLOR ? 0 : unColor);
+				break;
+			}
+			default:
+				// -0 and 0 are read alike.
+				f_value = (f_value == 0 ? 0 : f_value);
+				// The shortest writing that reads back to the same value.
+				for (UInt32 unPrecision = 15; unPrecision <= 17; ++unPrecision) {
+					oss.str("");
+					oss.precision(unPrecision);
+					oss << f_value;
+					if (strtod(oss.str().c_str(), NULL) == f_value) {
+						break;
+					}
+				}
+		}
+		return oss.str();
+	}
+}
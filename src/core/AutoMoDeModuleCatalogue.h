@@ -0,0 +1,65 @@
+/*
+ * @file <src/core/AutoMoDeModuleCatalogue.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This file describes the modules (behaviours and conditions) the
+ * 				finite state machines can be made of: their identifier in the
+ * 				configuration, their label and the parameters they read, with
+ * 				the way they interpret them.
+ */
+
+#ifndef AUTOMODE_MODULE_CATALOGUE_H
+#define AUTOMODE_MODULE_CATALOGUE_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+
+#include "../modules/AutoMoDeParameters.h"
+
+#include <string>
+
+namespace argos {
+	/*
+	 * How a module interprets the value of one of its parameters.
+	 */
+	enum EAutoMoDeParameterType {
+		/* Used as is. */
+		PARAMETER_REAL,
+		/* Truncated to an integer. */
+		PARAMETER_INTEGER,
+		/* Truncated to the index of a color. Indexes above the last color mean black (0). */
+		PARAMETER_COLOR
+	};
+
+	struct SAutoMoDeParameterDescription {
+		AutoMoDeParameters::EParameter Parameter;
+		EAutoMoDeParameterType Type;
+	};
+
+	struct SAutoMoDeModuleDescription {
+		UInt32 Identifier;
+		const char* Label;
+		UInt32 NumberParameters;
+		SAutoMoDeParameterDescription Parameters[3];
+	};
+
+	/*
+	 * Returns the description of the behaviour with the given identifier, or NULL if there is none.
+	 */
+	const SAutoMoDeModuleDescription* GetBehaviourDescription(UInt32 un_identifier);
+
+	/*
+	 * Returns the description of the condition with the given identifier, or NULL if there is none.
+	 */
+	const SAutoMoDeModuleDescription* GetConditionDescription(UInt32 un_identifier);
+
+	/*
+	 * Returns the value as the module reads it, written in a unique way: integers and colors
+	 * without decimals, reals with enough digits to be read back exactly.
+	 */
+	std::string FormatParameterValue(EAutoMoDeParameterType e_type, Real f_value);
+}
+
+#endif
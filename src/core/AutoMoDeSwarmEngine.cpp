@@ -0,0 +1,204 @@
+/*
+ * @file <src/core/AutoMoDeSwarmEngine.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeSwarmEngine.h"
+
+namespace argos {
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeSwarmEngine::AutoMoDeSwarmEngine() {
+		m_unNumberRobots = 0;
+		m_pcSimulator = NULL;
+		m_pcLoopFunctions = NULL;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeSwarmEngine::~AutoMoDeSwarmEngine() {
+		Detach();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Attach(CSimulator& c_simulator) {
+		if (m_pcSimulator != NULL) {
+			THROW_ARGOSEXCEPTION("The swarm engine is already attached to a simulator.");
+		}
+		m_pcSimulator = &c_simulator;
+		m_pcLoopFunctions = &c_simulator.GetLoopFunctions();
+		c_simulator.SetLoopFunctions(*this);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Detach() {
+		if (m_pcSimulator != NULL) {
+			m_pcSimulator->SetLoopFunctions(*m_pcLoopFunctions);
+			m_pcSimulator = NULL;
+			m_pcLoopFunctions = NULL;
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	CLoopFunctions& AutoMoDeSwarmEngine::GetLoopFunctions() {
+		if (m_pcLoopFunctions == NULL) {
+			THROW_ARGOSEXCEPTION("The swarm engine is not attached to a simulator.");
+		}
+		return *m_pcLoopFunctions;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::AddRobot(AutoMoDeController* pc_controller, UInt32 un_group) {
+		if (un_group >= m_vecGroups.size()) {
+			m_vecGroups.resize(un_group + 1);
+		}
+		SGroup& sGroup = m_vecGroups.at(un_group);
+		AutoMoDeFiniteStateMachine* pcFsm = pc_controller->GetFiniteStateMachine();
+		// Growing the array moves the states: they are given back to their finite state machine meanwhile.
+		bool bGrowing = (sGroup.States.size() == sGroup.States.capacity());
+		if (bGrowing) {
+			UnbindStates(sGroup);
+		}
+		sGroup.States.push_back(pcFsm->GetStepState());
+		sGroup.Fsm.push_back(pcFsm);
+		sGroup.Controllers.push_back(pc_controller);
+		if (bGrowing) {
+			BindStates(sGroup);
+		} else {
+			pcFsm->SetStepState(&sGroup.States.back());
+		}
+		pc_controller->SetExternalStepping(true);
+		m_unNumberRobots++;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Clear() {
+		for (UInt32 i = 0; i < m_vecGroups.size(); ++i) {
+			UnbindStates(m_vecGroups[i]);
+			for (UInt32 j = 0; j < m_vecGroups[i].Controllers.size(); ++j) {
+				m_vecGroups[i].Controllers[j]->SetExternalStepping(false);
+			}
+		}
+		// The arrays keep their capacity for the next robots.
+		for (UInt32 i = 0; i < m_vecGroups.size(); ++i) {
+			m_vecGroups[i].States.clear();
+			m_vecGroups[i].Fsm.clear();
+			m_vecGroups[i].Controllers.clear();
+		}
+		m_unNumberRobots = 0;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Step() {
+		for (UInt32 i = 0; i < m_vecGroups.size(); ++i) {
+			SGroup& sGroup = m_vecGroups[i];
+			UInt32 unNumberRobots = sGroup.Fsm.size();
+			for (UInt32 j = 0; j < unNumberRobots; ++j) {
+				sGroup.Fsm[j]->ControlStep();
+			}
+			for (UInt32 j = 0; j < unNumberRobots; ++j) {
+				sGroup.Controllers[j]->Actuate();
+			}
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	UInt32 AutoMoDeSwarmEngine::GetNumberRobots() const {
+		return m_unNumberRobots;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::BindStates(SGroup& s_group) {
+		for (UInt32 j = 0; j < s_group.Fsm.size(); ++j) {
+			s_group.Fsm[j]->SetStepState(&s_group.States[j]);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::UnbindStates(SGroup& s_group) {
+		for (UInt32 j = 0; j < s_group.Fsm.size(); ++j) {
+			s_group.Fsm[j]->SetStepState(NULL);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Init(TConfigurationNode& t_tree) {
+		GetLoopFunctions().Init(t_tree);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Reset() {
+		GetLoopFunctions().Reset();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::Destroy() {
+		GetLoopFunctions().Destroy();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::PreStep() {
+		GetLoopFunctions().PreStep();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::PostStep() {
+		Step();
+		GetLoopFunctions().PostStep();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeSwarmEngine::IsExperimentFinished() {
+		return GetLoopFunctions().IsExperimentFinished();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeSwarmEngine::PostExperiment() {
+		GetLoopFunctions().PostExperiment();
+	}
+
+	/****************************************/
+	/****************************************/
+
+	CColor AutoMoDeSwarmEngine::GetFloorColor(const CVector2& c_position_on_plane) {
+		return GetLoopFunctions().GetFloorColor(c_position_on_plane);
+	}
+}
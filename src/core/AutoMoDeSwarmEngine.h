@@ -0,0 +1,147 @@
+/*
+ * @file <src/core/AutoMoDeSwarmEngine.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class steps the finite state machines of a whole swarm, instead
+ * 				of each controller stepping its own. The robots are kept group
+ * 				by group: the state each finite state machine reads and writes
+ * 				at each step (active state, time step, outgoing transitions,
+ * 				random numbers) lies in one array per group, so that the robots
+ * 				running the same finite state machine (and sharing its transition
+ * 				table) are stepped one after the other over contiguous memory.
+ * 				The engine is attached to the simulator in place of the loop
+ * 				functions of the experiment, to which it forwards every call.
+ * 				The controllers added to the engine only update their robot state
+ * 				in ControlStep(). In PostStep(), once all the controllers sensed,
+ * 				the engine steps all the finite state machines, then writes the
+ * 				actuators of all the robots. As the actuators are only applied at
+ * 				the next tick, this is the same tick as the one of the controllers.
+ * 				PreStep() would step the robots one tick late, and miss the last
+ * 				tick of the experiment. As the engine is driven by the simulator,
+ * 				it works with any way of running it, visualization included.
+ */
+
+#ifndef AUTOMODE_SWARM_ENGINE_H
+#define AUTOMODE_SWARM_ENGINE_H
+
+#include <argos3/core/simulator/loop_functions.h>
+#include <argos3/core/simulator/simulator.h>
+
+#include "AutoMoDeController.h"
+#include "AutoMoDeFiniteStateMachine.h"
+
+#include <vector>
+
+namespace argos {
+	class AutoMoDeSwarmEngine: public CLoopFunctions {
+		public:
+			/*
+			 * Class constructor.
+			 */
+			AutoMoDeSwarmEngine();
+
+			/*
+			 * Class destructor. Detaches the engine if needed. The controllers, which may be
+			 * destroyed already, are not touched.
+			 */
+			virtual ~AutoMoDeSwarmEngine();
+
+			/*
+			 * Takes the place of the loop functions of the loaded experiment of c_simulator.
+			 * Must be detached before the simulator is destroyed, as the simulator deletes
+			 * its loop functions.
+			 */
+			void Attach(CSimulator& c_simulator);
+
+			/*
+			 * Gives their place back to the loop functions of the experiment.
+			 */
+			void Detach();
+
+			/*
+			 * Returns the loop functions of the experiment.
+			 */
+			CLoopFunctions& GetLoopFunctions();
+
+			/*
+			 * Adds a robot of group un_group, whose controller was given its finite state
+			 * machine. From then on, the controller leaves the stepping to the engine, and
+			 * the state of the finite state machine lies in the array of the group.
+			 */
+			void AddRobot(AutoMoDeController* pc_controller, UInt32 un_group);
+
+			/*
+			 * Removes all the robots, and gives back their state and their stepping to the
+			 * finite state machines and the controllers.
+			 */
+			void Clear();
+
+			/*
+			 * Steps the finite state machines of all the robots, group by group, then writes
+			 * their actuators. Called once per tick, after all the controllers sensed.
+			 */
+			void Step();
+
+			/*
+			 * Returns the number of robots stepped by the engine.
+			 */
+			UInt32 GetNumberRobots() const;
+
+			/*
+			 * Calls forwarded to the loop functions of the experiment.
+			 */
+			virtual void Init(TConfigurationNode& t_tree);
+			virtual void Reset();
+			virtual void Destroy();
+			virtual void PreStep();
+			virtual void PostStep();
+			virtual bool IsExperimentFinished();
+			virtual void PostExperiment();
+			virtual CColor GetFloorColor(const CVector2& c_position_on_plane);
+
+		private:
+			/*
+			 * Copying would step the robots twice.
+			 */
+			AutoMoDeSwarmEngine(const AutoMoDeSwarmEngine&);
+			AutoMoDeSwarmEngine& operator=(const AutoMoDeSwarmEngine&);
+
+			/*
+			 * Robots of a group: element i of the three arrays belongs to the same robot.
+			 */
+			struct SGroup {
+				std::vector<AutoMoDeFiniteStateMachine::SStepState> States;
+				std::vector<AutoMoDeFiniteStateMachine*> Fsm;
+				std::vector<AutoMoDeController*> Controllers;
+			};
+
+			/*
+			 * Gives the finite state machines of s_group their state in the array of the group.
+			 */
+			static void BindStates(SGroup& s_group);
+
+			/*
+			 * Gives back their state to the finite state machines of s_group.
+			 */
+			static void UnbindStates(SGroup& s_group);
+
+			/*
+			 * Robots of each group, indexed by group.
+			 */
+			std::vector<SGroup> m_vecGroups;
+
+			UInt32 m_unNumberRobots;
+
+			/*
+			 * The simulator the engine is attached to, and the loop functions of its
+			 * experiment, or NULL.
+			 */
+			CSimulator* m_pcSimulator;
+			CLoopFunctions* m_pcLoopFunctions;
+	};
+}
+
+#endif
@@ -13,6 +13,20 @@
 
 namespace argos {
 
+	AutoMoDeBehaviour::AutoMoDeBehaviour() :
+		m_pcRandomStream(NULL),
+		m_eType(BEHAVIOUR_EXTERNAL) {}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeBehaviour::AutoMoDeBehaviour(EBehaviourType e_type) :
+		m_pcRandomStream(NULL),
+		m_eType(e_type) {}
+
+	/****************************************/
+	/****************************************/
+
 	AutoMoDeBehaviour::~AutoMoDeBehaviour() {}
 
 	/****************************************/
@@ -56,10 +70,10 @@ namespace argos {
 	const std::string AutoMoDeBehaviour::GetDOTDescription() {
 		std::stringstream ss;
 		ss << m_strLabel;
-		if (!m_mapParameters.empty()) {
-			std::map<std::string, Real>::iterator it;
-			for (it = m_mapParameters.begin(); it != m_mapParameters.end(); it++) {
-				ss << "\\n" << it->first << "=" << it->second ;
+		for (UInt32 i = 0; i < AutoMoDeParameters::NUMBER_PARAMETERS; i++) {
+			AutoMoDeParameters::EParameter eParameter = (AutoMoDeParameters::EParameter) i;
+			if (m_cParameters.Has(eParameter)) {
+				ss << "\\n" << AutoMoDeParameters::GetName(eParameter) << "=" << m_cParameters.Get(eParameter) ;
 			}
 		}
 		return ss.str();
@@ -115,8 +129,8 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeBehaviour::AddParameter(const std::string& str_identifier, const Real& f_value) {
-		m_mapParameters.insert(std::pair<std::string, Real>(str_identifier, f_value));
+	void AutoMoDeBehaviour::AddParameter(AutoMoDeParameters::EParameter e_parameter, const Real& f_value) {
+		m_cParameters.Set(e_parameter, f_value);
 	}
 
 	/****************************************/
@@ -136,8 +150,19 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	const std::map<std::string, Real> AutoMoDeBehaviour::GetParameters() {
-		return m_mapParameters;
+	const Real& AutoMoDeBehaviour::GetParameter(const std::string& str_identifier) {
+		AutoMoDeParameters::EParameter eParameter;
+		if (!AutoMoDeParameters::FindParameter(str_identifier, eParameter) || !m_cParameters.Has(eParameter)) {
+			THROW_ARGOSEXCEPTION("The behaviour " << m_strLabel << " has no parameter " << str_identifier);
+		}
+		return m_cParameters.Get(eParameter);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const AutoMoDeParameters& AutoMoDeBehaviour::GetParameters() const {
+		return m_cParameters;
 	}
 
 	/****************************************/
@@ -147,6 +172,13 @@ namespace argos {
 		m_pcRobotDAO = pc_robot_dao;
 	}
 
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeBehaviour::SetRandomStream(AutoMoDeRandomStream* pc_random_stream) {
+		m_pcRandomStream = pc_random_stream;
+	}
+
     /****************************************/
     /****************************************/
     // Return the color parameter
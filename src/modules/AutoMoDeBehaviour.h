@@ -20,10 +20,30 @@
 
 #include <argos3/demiurge/epuck-dao/EpuckDAO.h>
 
-#include <map>
+#include "AutoMoDeParameters.h"
+#include "AutoMoDeRandomStream.h"
 
 namespace argos {
 	class AutoMoDeBehaviour {
+		public:
+			/*
+			 * The behaviours of this library. The finite state machine calls them
+			 * directly instead of going through the virtual methods, which remain for
+			 * the behaviours defined elsewhere (BEHAVIOUR_EXTERNAL). The behaviours of
+			 * this library are final, so that these calls cannot miss an override.
+			 */
+			enum EBehaviourType {
+				BEHAVIOUR_EXTERNAL,
+				BEHAVIOUR_EXPLORATION,
+				BEHAVIOUR_STOP,
+				BEHAVIOUR_PHOTOTAXIS,
+				BEHAVIOUR_ANTI_PHOTOTAXIS,
+				BEHAVIOUR_ATTRACTION,
+				BEHAVIOUR_REPULSION,
+				BEHAVIOUR_GO_TO_COLOR,
+				BEHAVIOUR_GO_AWAY_COLOR
+			};
+
 		protected:
 			/*
 			 * Tells whether or not the behaviour is locked for a given
@@ -41,7 +61,7 @@ namespace argos {
 			/*
 			 * Contains the parameters of the behaviours.
 			 */
-			std::map<std::string, Real> m_mapParameters;
+			AutoMoDeParameters m_cParameters;
 
 			/*
 			 * The name of the behaviour.
@@ -64,7 +84,21 @@ namespace argos {
 			 */
       EpuckDAO* m_pcRobotDAO;
 
+			/*
+			 * Pointer to the random numbers of the robot, owned by the finite state machine.
+			 */
+			AutoMoDeRandomStream* m_pcRandomStream;
+
+			/*
+			 * Class constructor, for the behaviours of this library.
+			 */
+			AutoMoDeBehaviour(EBehaviourType e_type);
+
 		public:
+			/*
+			 * Class constructor, for the behaviours defined elsewhere.
+			 */
+			AutoMoDeBehaviour();
 
 		 virtual ~AutoMoDeBehaviour();
 			/*
@@ -101,19 +135,21 @@ namespace argos {
 			const std::string GetDOTDescription();
 
 			/*
-			 * Instert a pair <parameter, value> to the parameters map.
+			 * Gives a value to a parameter.
 			 */
-			void AddParameter(const std::string& str_identifier, const Real& f_value);
+			void AddParameter(AutoMoDeParameters::EParameter e_parameter, const Real& f_value);
 
 			/*
-			 * Returns the value of a given parameter from the parameters map.
+			 * Returns the value of a parameter, given by its name in the configurations
+			 * (e.g. rwm). Kept for the behaviours defined elsewhere: the name is resolved at
+			 * each call, so the behaviours of this library read m_cParameters instead.
 			 */
 			const Real& GetParameter(const std::string& str_identifier);
 
 			/*
-			 * Returns the whole parameters map.
+			 * Returns all the parameters.
 			 */
-			const std::map<std::string, Real> GetParameters();
+			const AutoMoDeParameters& GetParameters() const;
 
 			/*
 			 * Setter for the index of the behaviour.
@@ -135,6 +171,13 @@ namespace argos {
 			 */
 			const UInt32& GetIdentifier() const;
 
+			/*
+			 * Returns which behaviour of this library this is, or BEHAVIOUR_EXTERNAL.
+			 */
+			EBehaviourType GetType() const {
+				return m_eType;
+			}
+
 			/*
 			 * Getter for the label (name) of the behaviour.
 			 */
@@ -170,10 +213,18 @@ namespace argos {
 			 */
 			void SetRobotDAO(EpuckDAO* pc_robot_dao);
 
+			/*
+			 * Setter for the pointer to the random numbers of the robot.
+			 */
+			void SetRandomStream(AutoMoDeRandomStream* pc_random_stream);
+
             /*
              * Data transform for color of the omnidirectional camera and LEDs.
              */
             CColor GetColorParameter(const UInt32& un_value, const bool& b_emiter);
+
+		private:
+			EBehaviourType m_eType;
 	};
 }
 
@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourAntiPhototaxis: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourAntiPhototaxis final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourAntiPhototaxis();
 			AutoMoDeBehaviourAntiPhototaxis(AutoMoDeBehaviourAntiPhototaxis* pc_behaviour);
@@ -16,20 +16,20 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeBehaviourAttraction::AutoMoDeBehaviourAttraction() {
+	AutoMoDeBehaviourAttraction::AutoMoDeBehaviourAttraction() : AutoMoDeBehaviour(BEHAVIOUR_ATTRACTION) {
 		m_strLabel = "Attraction";
 	}
 
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeBehaviourAttraction::AutoMoDeBehaviourAttraction(AutoMoDeBehaviourAttraction* pc_behaviour) {
+	AutoMoDeBehaviourAttraction::AutoMoDeBehaviourAttraction(AutoMoDeBehaviourAttraction* pc_behaviour) : AutoMoDeBehaviour(BEHAVIOUR_ATTRACTION) {
 		m_strLabel = pc_behaviour->GetLabel();
 		m_bLocked = pc_behaviour->IsLocked();
 		m_bOperational = pc_behaviour->IsOperational();
 		m_unIndex = pc_behaviour->GetIndex();
 		m_unIdentifier = pc_behaviour->GetIdentifier();
-		m_mapParameters = pc_behaviour->GetParameters();
+		m_cParameters = pc_behaviour->GetParameters();
 		Init();
 	}
 
@@ -75,16 +75,14 @@ namespace argos {
 	/****************************************/
 
 	void AutoMoDeBehaviourAttraction::Init() {
-		std::map<std::string, Real>::iterator it = m_mapParameters.find("att");
-		if (it != m_mapParameters.end()) {
-			m_unAttractionParameter = it->second;
+		if (m_cParameters.Has(AutoMoDeParameters::ATT)) {
+			m_unAttractionParameter = m_cParameters.Get(AutoMoDeParameters::ATT);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
 		}
-        it = m_mapParameters.find("cle");
-        if (it != m_mapParameters.end()) {
-            m_cColorEmiterParameter = GetColorParameter(it->second, true);
+        if (m_cParameters.Has(AutoMoDeParameters::CLE)) {
+            m_cColorEmiterParameter = GetColorParameter(m_cParameters.Get(AutoMoDeParameters::CLE), true);
         } else {
             LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourAttraction: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourAttraction final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourAttraction();
 			AutoMoDeBehaviourAttraction(AutoMoDeBehaviourAttraction* pc_behaviour);
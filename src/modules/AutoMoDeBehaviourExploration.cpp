@@ -16,20 +16,20 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeBehaviourExploration::AutoMoDeBehaviourExploration() {
+	AutoMoDeBehaviourExploration::AutoMoDeBehaviourExploration() : AutoMoDeBehaviour(BEHAVIOUR_EXPLORATION) {
 		m_strLabel = "Exploration";
 	}
 
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeBehaviourExploration::AutoMoDeBehaviourExploration(AutoMoDeBehaviourExploration* pc_behaviour) {
+	AutoMoDeBehaviourExploration::AutoMoDeBehaviourExploration(AutoMoDeBehaviourExploration* pc_behaviour) : AutoMoDeBehaviour(BEHAVIOUR_EXPLORATION) {
 		m_strLabel = pc_behaviour->GetLabel();
 		m_bLocked = pc_behaviour->IsLocked();
 		m_bOperational = pc_behaviour->IsOperational();
 		m_unIndex = pc_behaviour->GetIndex();
 		m_unIdentifier = pc_behaviour->GetIdentifier();
-		m_mapParameters = pc_behaviour->GetParameters();
+		m_cParameters = pc_behaviour->GetParameters();
 		Init();
 	}
 
@@ -53,16 +53,14 @@ namespace argos {
 		m_eExplorationState = RANDOM_WALK;
 		m_fProximityThreshold = 0.1;
 		m_bLocked = false;
-		std::map<std::string, Real>::iterator it = m_mapParameters.find("rwm");
-		if (it != m_mapParameters.end()) {
-			m_cRandomStepsRange.SetMax(it->second);
+		if (m_cParameters.Has(AutoMoDeParameters::RWM)) {
+			m_cRandomStepsRange.SetMax(m_cParameters.Get(AutoMoDeParameters::RWM));
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
 		}
-        it = m_mapParameters.find("cle");
-        if (it != m_mapParameters.end()) {
-            m_cColorEmiterParameter = GetColorParameter(it->second, true);
+        if (m_cParameters.Has(AutoMoDeParameters::CLE)) {
+            m_cColorEmiterParameter = GetColorParameter(m_cParameters.Get(AutoMoDeParameters::CLE), true);
         } else {
             LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -78,7 +76,11 @@ namespace argos {
 				m_pcRobotDAO->SetWheelsVelocity(m_pcRobotDAO->GetMaxVelocity(), m_pcRobotDAO->GetMaxVelocity());
 				if (IsObstacleInFront(m_pcRobotDAO->GetProximityReading())) {
 					m_eExplorationState = OBSTACLE_AVOIDANCE;
-					m_unTurnSteps = (m_pcRobotDAO->GetRandomNumberGenerator())->Uniform(m_cRandomStepsRange);
+					if (m_pcRandomStream == NULL) {
+						m_unTurnSteps = m_pcRobotDAO->GetRandomNumberGenerator()->Uniform(m_cRandomStepsRange);
+					} else {
+						m_unTurnSteps = m_pcRandomStream->Uniform(m_cRandomStepsRange);
+					}
 					CRadians cAngle = m_pcRobotDAO->GetProximityReading().Angle.SignedNormalize();
 					if (cAngle.GetValue() < 0) {
 						m_eTurnDirection = LEFT;
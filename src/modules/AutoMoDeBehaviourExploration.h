@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourExploration: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourExploration final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourExploration();
 			AutoMoDeBehaviourExploration(AutoMoDeBehaviourExploration* pc_behaviour);
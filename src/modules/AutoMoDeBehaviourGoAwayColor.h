@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-    class AutoMoDeBehaviourGoAwayColor: public AutoMoDeBehaviour {
+    class AutoMoDeBehaviourGoAwayColor final: public AutoMoDeBehaviour {
 		public:
             AutoMoDeBehaviourGoAwayColor();
             AutoMoDeBehaviourGoAwayColor(AutoMoDeBehaviourGoAwayColor* pc_behaviour);
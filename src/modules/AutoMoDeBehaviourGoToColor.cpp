@@ -16,20 +16,20 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-    AutoMoDeBehaviourGoToColor::AutoMoDeBehaviourGoToColor() {
+    AutoMoDeBehaviourGoToColor::AutoMoDeBehaviourGoToColor() : AutoMoDeBehaviour(BEHAVIOUR_GO_TO_COLOR) {
         m_strLabel = "GoToColor";
 	}
 
 	/****************************************/
 	/****************************************/
 
-    AutoMoDeBehaviourGoToColor::AutoMoDeBehaviourGoToColor(AutoMoDeBehaviourGoToColor* pc_behaviour) {
+    AutoMoDeBehaviourGoToColor::AutoMoDeBehaviourGoToColor(AutoMoDeBehaviourGoToColor* pc_behaviour) : AutoMoDeBehaviour(BEHAVIOUR_GO_TO_COLOR) {
 		m_strLabel = pc_behaviour->GetLabel();
 		m_bLocked = pc_behaviour->IsLocked();
 		m_bOperational = pc_behaviour->IsOperational();
 		m_unIndex = pc_behaviour->GetIndex();
 		m_unIdentifier = pc_behaviour->GetIdentifier();
-		m_mapParameters = pc_behaviour->GetParameters();
+		m_cParameters = pc_behaviour->GetParameters();
 		Init();
 	}
 
@@ -76,23 +76,20 @@ namespace argos {
 	/****************************************/
 
     void AutoMoDeBehaviourGoToColor::Init() {
-        std::map<std::string, Real>::iterator it = m_mapParameters.find("vel");
-		if (it != m_mapParameters.end()) {
-			m_unAttractionParameter = it->second;
+        if (m_cParameters.Has(AutoMoDeParameters::VEL)) {
+			m_unAttractionParameter = m_cParameters.Get(AutoMoDeParameters::VEL);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
 		}
-        it = m_mapParameters.find("cle");
-        if (it != m_mapParameters.end()) {
-            m_cColorEmiterParameter = GetColorParameter(it->second, true);
+        if (m_cParameters.Has(AutoMoDeParameters::CLE)) {
+            m_cColorEmiterParameter = GetColorParameter(m_cParameters.Get(AutoMoDeParameters::CLE), true);
         } else {
             LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
         }
-        it = m_mapParameters.find("clr");
-        if (it != m_mapParameters.end()) {
-            m_cColorReceiverParameter = GetColorParameter(it->second, false);
+        if (m_cParameters.Has(AutoMoDeParameters::CLR)) {
+            m_cColorReceiverParameter = GetColorParameter(m_cParameters.Get(AutoMoDeParameters::CLR), false);
         } else {
             LOGERR << "[FATAL] Missing parameter for the following behaviour:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-    class AutoMoDeBehaviourGoToColor: public AutoMoDeBehaviour {
+    class AutoMoDeBehaviourGoToColor final: public AutoMoDeBehaviour {
 		public:
             AutoMoDeBehaviourGoToColor();
             AutoMoDeBehaviourGoToColor(AutoMoDeBehaviourGoToColor* pc_behaviour);
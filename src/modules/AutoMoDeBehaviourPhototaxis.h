@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourPhototaxis: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourPhototaxis final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourPhototaxis();
 			AutoMoDeBehaviourPhototaxis(AutoMoDeBehaviourPhototaxis* pc_behaviour);
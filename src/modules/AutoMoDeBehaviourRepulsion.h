@@ -14,7 +14,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourRepulsion: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourRepulsion final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourRepulsion();
 			AutoMoDeBehaviourRepulsion(AutoMoDeBehaviourRepulsion* pc_behaviour);
@@ -15,7 +15,7 @@
 #include "AutoMoDeBehaviour.h"
 
 namespace argos {
-	class AutoMoDeBehaviourStop: public AutoMoDeBehaviour {
+	class AutoMoDeBehaviourStop final: public AutoMoDeBehaviour {
 		public:
 			AutoMoDeBehaviourStop();
 			AutoMoDeBehaviourStop(AutoMoDeBehaviourStop* pc_behaviour);
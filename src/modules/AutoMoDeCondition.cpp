@@ -18,10 +18,10 @@ namespace argos {
 	const std::string AutoMoDeCondition::GetDOTDescription() {
 		std::stringstream ss;
 		ss << m_strLabel;
-		if (!m_mapParameters.empty()) {
-			std::map<std::string, Real>::iterator it;
-			for (it = m_mapParameters.begin(); it != m_mapParameters.end(); it++) {
-				ss << "\\n" << it->first << "=" << it->second ;
+		for (UInt32 i = 0; i < AutoMoDeParameters::NUMBER_PARAMETERS; i++) {
+			AutoMoDeParameters::EParameter eParameter = (AutoMoDeParameters::EParameter) i;
+			if (m_cParameters.Has(eParameter)) {
+				ss << "\\n" << AutoMoDeParameters::GetName(eParameter) << "=" << m_cParameters.Get(eParameter) ;
 			}
 		}
 		return ss.str();
@@ -30,8 +30,8 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	void AutoMoDeCondition::AddParameter(const std::string& str_identifier, const Real& f_value) {
-		m_mapParameters.insert(std::pair<std::string, Real>(str_identifier, f_value));
+	void AutoMoDeCondition::AddParameter(AutoMoDeParameters::EParameter e_parameter, const Real& f_value) {
+		m_cParameters.Set(e_parameter, f_value);
 	}
 
 	/****************************************/
@@ -108,8 +108,19 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
-	std::map<std::string, Real> AutoMoDeCondition::GetParameters() const {
-		return m_mapParameters;
+	Real AutoMoDeCondition::GetParameter(const std::string& str_identifier) {
+		AutoMoDeParameters::EParameter eParameter;
+		if (!AutoMoDeParameters::FindParameter(str_identifier, eParameter) || !m_cParameters.Has(eParameter)) {
+			THROW_ARGOSEXCEPTION("The condition " << m_strLabel << " has no parameter " << str_identifier);
+		}
+		return m_cParameters.Get(eParameter);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const AutoMoDeParameters& AutoMoDeCondition::GetParameters() const {
+		return m_cParameters;
 	}
 
   /****************************************/
@@ -122,8 +133,25 @@ namespace argos {
 	/****************************************/
 	/****************************************/
 
+  void AutoMoDeCondition::SetRandomStream(AutoMoDeRandomStream* pc_random_stream) {
+      m_pcRandomStream = pc_random_stream;
+  }
+
+	/****************************************/
+	/****************************************/
+
   bool AutoMoDeCondition::EvaluateBernoulliProbability(const Real& f_probability) const {
-		return m_pcRobotDAO->GetRandomNumberGenerator()->Bernoulli(f_probability);
+		return EvaluateBernoulliProbability(m_pcRobotDAO, m_pcRandomStream, f_probability);
+	}
+
+	/****************************************/
+	/****************************************/
+
+  bool AutoMoDeCondition::EvaluateBernoulliProbability(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream, const Real& f_probability) const {
+		if (pc_random_stream == NULL) {
+			return pc_robot_dao->GetRandomNumberGenerator()->Bernoulli(f_probability);
+		}
+		return pc_random_stream->Bernoulli(f_probability);
 	}
 
   /****************************************/
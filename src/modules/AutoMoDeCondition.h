@@ -16,15 +16,34 @@
 
 #include <argos3/demiurge/epuck-dao/EpuckDAO.h>
 
-#include <map>
+#include "AutoMoDeParameters.h"
+#include "AutoMoDeRandomStream.h"
 
 namespace argos {
 	class AutoMoDeCondition {
+		public:
+			/*
+			 * The conditions of this library. The finite state machine calls them
+			 * directly instead of going through the virtual methods, which remain for
+			 * the conditions defined elsewhere (CONDITION_EXTERNAL). The conditions of
+			 * this library are final, so that these calls cannot miss an override.
+			 */
+			enum EConditionType {
+				CONDITION_EXTERNAL,
+				CONDITION_BLACK_FLOOR,
+				CONDITION_GRAY_FLOOR,
+				CONDITION_WHITE_FLOOR,
+				CONDITION_NEIGHBORS_COUNT,
+				CONDITION_INVERTED_NEIGHBORS_COUNT,
+				CONDITION_FIXED_PROBABILITY,
+				CONDITION_PROB_COLOR
+			};
+
 		protected:
 			/*
-			 * Map containing all parameters of the condition.
+			 * All parameters of the condition.
 			 */
-			std::map<std::string, Real> m_mapParameters;
+			AutoMoDeParameters m_cParameters;
 
 			/*
 			 * Index of the behaviour at the origin of the condition.
@@ -56,7 +75,25 @@ namespace argos {
 			 */
 			EpuckDAO* m_pcRobotDAO;
 
+			/*
+			 * Pointer to the random numbers of the robot, owned by the finite state machine.
+			 */
+			AutoMoDeRandomStream* m_pcRandomStream;
+
+			/*
+			 * Class constructor, for the conditions of this library.
+			 */
+			AutoMoDeCondition(EConditionType e_type) :
+				m_pcRandomStream(NULL),
+				m_eType(e_type) {}
+
 		public:
+			/*
+			 * Class constructor, for the conditions defined elsewhere.
+			 */
+			AutoMoDeCondition() :
+				m_pcRandomStream(NULL),
+				m_eType(CONDITION_EXTERNAL) {}
 
 			virtual ~AutoMoDeCondition(){};
 
@@ -111,19 +148,28 @@ namespace argos {
 			const UInt32& GetIdentifier() const;
 
 			/*
-			 * Adds a pair <parameter, value> to the parameters map.
+			 * Gives a value to a parameter.
 			 */
-			void AddParameter(const std::string& str_identifier, const Real& f_value);
+			void AddParameter(AutoMoDeParameters::EParameter e_parameter, const Real& f_value);
 
 			/*
-			 * Returns the value of a given parameter from the parameters map.
+			 * Returns the value of a parameter, given by its name in the configurations
+			 * (e.g. rwm). Kept for the conditions defined elsewhere: the name is resolved at
+			 * each call, so the conditions of this library read m_cParameters instead.
 			 */
 			Real GetParameter(const std::string& str_identifier);
 
 			/*
-			 * Returns the whole parameter map.
+			 * Returns all the parameters.
 			 */
-			std::map<std::string, Real> GetParameters() const;
+			const AutoMoDeParameters& GetParameters() const;
+
+			/*
+			 * Returns which condition of this library this is, or CONDITION_EXTERNAL.
+			 */
+			EConditionType GetType() const {
+				return m_eType;
+			}
 
 			/*
 			 * Getter for the name of the label.
@@ -136,14 +182,30 @@ namespace argos {
 			void SetRobotDAO(EpuckDAO* pc_robot_dao);
 
 			/*
-			 * Returns a random value from a Bernoulli distribution.
+			 * Setter for the pointer to the random numbers of the robot.
+			 */
+			void SetRandomStream(AutoMoDeRandomStream* pc_random_stream);
+
+			/*
+			 * Returns a random value from a Bernoulli distribution, drawn from the random
+			 * numbers of the robot, or from the random number generator of the robot state
+			 * if they were not given.
 			 */
 			bool EvaluateBernoulliProbability(const Real& f_probability) const;
 
+			/*
+			 * Same as above, with the random numbers pc_random_stream and the robot state
+			 * pc_robot_dao.
+			 */
+			bool EvaluateBernoulliProbability(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream, const Real& f_probability) const;
+
             /*
              * Data transform for color of the LEDs.
              */
             CColor GetColorParameter(const UInt32 &un_value);
+
+		private:
+			EConditionType m_eType;
 	};
 }
 
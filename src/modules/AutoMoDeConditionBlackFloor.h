@@ -14,7 +14,7 @@
 #include "AutoMoDeCondition.h"
 
 namespace argos {
-	class AutoMoDeConditionBlackFloor: public AutoMoDeCondition {
+	class AutoMoDeConditionBlackFloor final: public AutoMoDeCondition {
 		public:
 			AutoMoDeConditionBlackFloor();
 			virtual ~AutoMoDeConditionBlackFloor();
@@ -23,6 +23,12 @@ namespace argos {
 			virtual AutoMoDeConditionBlackFloor* Clone();
 
 			virtual bool Verify();
+			/*
+			 * Same as Verify(), for the robot whose state is pc_robot_dao and whose random
+			 * numbers come from pc_random_stream. The condition is left untouched, so that
+			 * the robots of a group can share it.
+			 */
+			bool Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const;
 			virtual void Reset();
 			virtual void Init();
 
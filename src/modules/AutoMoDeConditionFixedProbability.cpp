@@ -15,7 +15,7 @@
   /****************************************/
   /****************************************/
 
-	AutoMoDeConditionFixedProbability::AutoMoDeConditionFixedProbability() {
+	AutoMoDeConditionFixedProbability::AutoMoDeConditionFixedProbability() : AutoMoDeCondition(CONDITION_FIXED_PROBABILITY) {
 		m_strLabel = "FixedProbability";
 	}
 
@@ -27,13 +27,13 @@
   /****************************************/
   /****************************************/
 
-	AutoMoDeConditionFixedProbability::AutoMoDeConditionFixedProbability(AutoMoDeConditionFixedProbability* pc_condition) {
+	AutoMoDeConditionFixedProbability::AutoMoDeConditionFixedProbability(AutoMoDeConditionFixedProbability* pc_condition) : AutoMoDeCondition(CONDITION_FIXED_PROBABILITY) {
 		m_strLabel = pc_condition->GetLabel();
 		m_unIndex = pc_condition->GetIndex();
 		m_unIdentifier = pc_condition->GetIndex();
 		m_unFromBehaviourIndex = pc_condition->GetOrigin();
 		m_unToBehaviourIndex = pc_condition->GetExtremity();
-		m_mapParameters = pc_condition->GetParameters();
+		m_cParameters = pc_condition->GetParameters();
     Init();
 	}
 
@@ -48,9 +48,8 @@
   /****************************************/
 
 	void AutoMoDeConditionFixedProbability::Init() {
-		std::map<std::string, Real>::iterator it = m_mapParameters.find("p");
-		if (it != m_mapParameters.end()) {
-			m_fProbability = it->second;
+		if (m_cParameters.Has(AutoMoDeParameters::P)) {
+			m_fProbability = m_cParameters.Get(AutoMoDeParameters::P);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -61,7 +60,14 @@
   /****************************************/
 
 	bool AutoMoDeConditionFixedProbability::Verify() {
-		return EvaluateBernoulliProbability(m_fProbability);
+		return Verify(m_pcRobotDAO, m_pcRandomStream);
+	}
+
+  /****************************************/
+  /****************************************/
+
+	bool AutoMoDeConditionFixedProbability::Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const {
+		return EvaluateBernoulliProbability(pc_robot_dao, pc_random_stream, m_fProbability);
 	}
 
   /****************************************/
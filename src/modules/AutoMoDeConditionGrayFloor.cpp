@@ -15,7 +15,7 @@
   /****************************************/
   /****************************************/
 
-	AutoMoDeConditionGrayFloor::AutoMoDeConditionGrayFloor() {
+	AutoMoDeConditionGrayFloor::AutoMoDeConditionGrayFloor() : AutoMoDeCondition(CONDITION_GRAY_FLOOR) {
 		m_strLabel = "GrayFloor";
 	}
 
@@ -27,13 +27,13 @@
   /****************************************/
   /****************************************/
 
-	AutoMoDeConditionGrayFloor::AutoMoDeConditionGrayFloor(AutoMoDeConditionGrayFloor* pc_condition) {
+	AutoMoDeConditionGrayFloor::AutoMoDeConditionGrayFloor(AutoMoDeConditionGrayFloor* pc_condition) : AutoMoDeCondition(CONDITION_GRAY_FLOOR) {
 		m_strLabel = pc_condition->GetLabel();
 		m_unIndex = pc_condition->GetIndex();
 		m_unIdentifier = pc_condition->GetIndex();
 		m_unFromBehaviourIndex = pc_condition->GetOrigin();
 		m_unToBehaviourIndex = pc_condition->GetExtremity();
-		m_mapParameters = pc_condition->GetParameters();
+		m_cParameters = pc_condition->GetParameters();
     Init();
 	}
 
@@ -48,8 +48,15 @@
   /****************************************/
 
 	bool AutoMoDeConditionGrayFloor::Verify() {
-    if (m_fGroundThresholdRange.WithinMinBoundExcludedMaxBoundExcluded(m_pcRobotDAO->GetGroundReading())) {
-      return EvaluateBernoulliProbability(m_fProbability);
+		return Verify(m_pcRobotDAO, m_pcRandomStream);
+	}
+
+  /****************************************/
+  /****************************************/
+
+	bool AutoMoDeConditionGrayFloor::Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const {
+    if (m_fGroundThresholdRange.WithinMinBoundExcludedMaxBoundExcluded(pc_robot_dao->GetGroundReading())) {
+      return EvaluateBernoulliProbability(pc_robot_dao, pc_random_stream, m_fProbability);
     }
     else {
       return false;
@@ -61,9 +68,8 @@
 
 	void AutoMoDeConditionGrayFloor::Init() {
 		m_fGroundThresholdRange.Set(0.1, 0.95);
-		std::map<std::string, Real>::iterator it = m_mapParameters.find("p");
-		if (it != m_mapParameters.end()) {
-			m_fProbability = it->second;
+		if (m_cParameters.Has(AutoMoDeParameters::P)) {
+			m_fProbability = m_cParameters.Get(AutoMoDeParameters::P);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -15,7 +15,7 @@
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeConditionNeighborsCount::AutoMoDeConditionNeighborsCount() {
+	AutoMoDeConditionNeighborsCount::AutoMoDeConditionNeighborsCount() : AutoMoDeCondition(CONDITION_NEIGHBORS_COUNT) {
 		m_strLabel = "NeighborsCount";
 	}
 
@@ -27,13 +27,13 @@
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeConditionNeighborsCount::AutoMoDeConditionNeighborsCount(AutoMoDeConditionNeighborsCount* pc_condition) {
+	AutoMoDeConditionNeighborsCount::AutoMoDeConditionNeighborsCount(AutoMoDeConditionNeighborsCount* pc_condition) : AutoMoDeCondition(CONDITION_NEIGHBORS_COUNT) {
 		m_strLabel = pc_condition->GetLabel();
 		m_unIndex = pc_condition->GetIndex();
 		m_unIdentifier = pc_condition->GetIndex();
 		m_unFromBehaviourIndex = pc_condition->GetOrigin();
 		m_unToBehaviourIndex = pc_condition->GetExtremity();
-		m_mapParameters = pc_condition->GetParameters();
+		m_cParameters = pc_condition->GetParameters();
     Init();
 	}
 
@@ -48,9 +48,16 @@
 	/****************************************/
 
 	bool AutoMoDeConditionNeighborsCount::Verify() {
-		UInt32 unNumberNeighbors = m_pcRobotDAO->GetNumberNeighbors();
+		return Verify(m_pcRobotDAO, m_pcRandomStream);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeConditionNeighborsCount::Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const {
+		UInt32 unNumberNeighbors = pc_robot_dao->GetNumberNeighbors();
                 Real fProbability = (1/(1 + exp(m_fParameterEta * ((int)m_unParameterXi - (int)unNumberNeighbors))));
-		return EvaluateBernoulliProbability(fProbability);
+		return EvaluateBernoulliProbability(pc_robot_dao, pc_random_stream, fProbability);
 	}
 
 	/****************************************/
@@ -64,11 +71,9 @@
 	/****************************************/
 
 	void AutoMoDeConditionNeighborsCount::Init() {
-		std::map<std::string, Real>::iterator itEta = m_mapParameters.find("w");
-		std::map<std::string, Real>::iterator itXi = m_mapParameters.find("p");
-		if ((itEta != m_mapParameters.end()) && (itXi != m_mapParameters.end())) {
-			m_fParameterEta = itEta->second;
-			m_unParameterXi = itXi->second;
+		if (m_cParameters.Has(AutoMoDeParameters::W) && m_cParameters.Has(AutoMoDeParameters::P)) {
+			m_fParameterEta = m_cParameters.Get(AutoMoDeParameters::W);
+			m_unParameterXi = m_cParameters.Get(AutoMoDeParameters::P);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -15,7 +15,7 @@
   /****************************************/
   /****************************************/
 
-    AutoMoDeConditionProbColor::AutoMoDeConditionProbColor() {
+    AutoMoDeConditionProbColor::AutoMoDeConditionProbColor() : AutoMoDeCondition(CONDITION_PROB_COLOR) {
         m_strLabel = "ProbColor";
 	}
 
@@ -27,13 +27,13 @@
   /****************************************/
   /****************************************/
 
-    AutoMoDeConditionProbColor::AutoMoDeConditionProbColor(AutoMoDeConditionProbColor* pc_condition) {
+    AutoMoDeConditionProbColor::AutoMoDeConditionProbColor(AutoMoDeConditionProbColor* pc_condition) : AutoMoDeCondition(CONDITION_PROB_COLOR) {
 		m_strLabel = pc_condition->GetLabel();
 		m_unIndex = pc_condition->GetIndex();
 		m_unIdentifier = pc_condition->GetIndex();
 		m_unFromBehaviourIndex = pc_condition->GetOrigin();
 		m_unToBehaviourIndex = pc_condition->GetExtremity();
-		m_mapParameters = pc_condition->GetParameters();
+		m_cParameters = pc_condition->GetParameters();
     Init();
 	}
 
@@ -41,16 +41,14 @@
   /****************************************/
 
     void AutoMoDeConditionProbColor::Init() {
-        std::map<std::string, Real>::iterator it = m_mapParameters.find("l");
-        if (it != m_mapParameters.end()) {
-            m_cColorParameter = GetColorParameter(it->second);
+        if (m_cParameters.Has(AutoMoDeParameters::L)) {
+            m_cColorParameter = GetColorParameter(m_cParameters.Get(AutoMoDeParameters::L));
         } else {
             LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
         }
-        it = m_mapParameters.find("p");
-        if (it != m_mapParameters.end()) {
-            m_fProbability = it->second;
+        if (m_cParameters.Has(AutoMoDeParameters::P)) {
+            m_fProbability = m_cParameters.Get(AutoMoDeParameters::P);
         } else {
             LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
             THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -68,7 +66,14 @@
   /****************************************/
 
     bool AutoMoDeConditionProbColor::Verify() {
-        CCI_EPuckOmnidirectionalCameraSensor::SReadings sReadings = m_pcRobotDAO->GetCameraInput();
+        return Verify(m_pcRobotDAO, m_pcRandomStream);
+    }
+
+  /****************************************/
+  /****************************************/
+
+    bool AutoMoDeConditionProbColor::Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const {
+        CCI_EPuckOmnidirectionalCameraSensor::SReadings sReadings = pc_robot_dao->GetCameraInput();
         CCI_EPuckOmnidirectionalCameraSensor::TBlobList::iterator it;
         bool bColorPerceived = false;
 
@@ -80,7 +85,7 @@
         }
 
         if (bColorPerceived){
-            return EvaluateBernoulliProbability(m_fProbability);
+            return EvaluateBernoulliProbability(pc_robot_dao, pc_random_stream, m_fProbability);
         }
 
     return false;
@@ -15,7 +15,7 @@
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeConditionWhiteFloor::AutoMoDeConditionWhiteFloor() {
+	AutoMoDeConditionWhiteFloor::AutoMoDeConditionWhiteFloor() : AutoMoDeCondition(CONDITION_WHITE_FLOOR) {
 		m_strLabel = "WhiteFloor";
 	}
 
@@ -28,8 +28,15 @@
 	/****************************************/
 
 	bool AutoMoDeConditionWhiteFloor::Verify() {
-    if (m_pcRobotDAO->GetGroundReading() >= m_fGroundThreshold) {
-      return EvaluateBernoulliProbability(m_fProbability);
+		return Verify(m_pcRobotDAO, m_pcRandomStream);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeConditionWhiteFloor::Verify(EpuckDAO* pc_robot_dao, AutoMoDeRandomStream* pc_random_stream) const {
+    if (pc_robot_dao->GetGroundReading() >= m_fGroundThreshold) {
+      return EvaluateBernoulliProbability(pc_robot_dao, pc_random_stream, m_fProbability);
     }
     else {
       return false;
@@ -39,13 +46,13 @@
 	/****************************************/
 	/****************************************/
 
-	AutoMoDeConditionWhiteFloor::AutoMoDeConditionWhiteFloor(AutoMoDeConditionWhiteFloor* pc_condition) {
+	AutoMoDeConditionWhiteFloor::AutoMoDeConditionWhiteFloor(AutoMoDeConditionWhiteFloor* pc_condition) : AutoMoDeCondition(CONDITION_WHITE_FLOOR) {
 		m_strLabel = pc_condition->GetLabel();
 		m_unIndex = pc_condition->GetIndex();
 		m_unIdentifier = pc_condition->GetIndex();
 		m_unFromBehaviourIndex = pc_condition->GetOrigin();
 		m_unToBehaviourIndex = pc_condition->GetExtremity();
-		m_mapParameters = pc_condition->GetParameters();
+		m_cParameters = pc_condition->GetParameters();
     Init();
 	}
 
@@ -61,9 +68,8 @@
 
 	void AutoMoDeConditionWhiteFloor::Init() {
 		m_fGroundThreshold = 0.95;
-		std::map<std::string, Real>::iterator it = m_mapParameters.find("p");
-		if (it != m_mapParameters.end()) {
-			m_fProbability = it->second;
+		if (m_cParameters.Has(AutoMoDeParameters::P)) {
+			m_fProbability = m_cParameters.Get(AutoMoDeParameters::P);
 		} else {
 			LOGERR << "[FATAL] Missing parameter for the following condition:" << m_strLabel << std::endl;
 			THROW_ARGOSEXCEPTION("Missing Parameter");
@@ -0,0 +1,64 @@
+/*
+ * @file <src/modules/AutoMoDeParameters.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeParameters.h"
+
+namespace argos {
+
+	/*
+	 * Names of the parameters, indexed by EParameter.
+	 */
+	static const char* PARAMETER_NAMES[] = {"rwm", "att", "rep", "vel", "cle", "clr", "p", "w", "l"};
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeParameters::AutoMoDeParameters() :
+		m_unDefined(0) {
+		for (UInt32 i = 0; i < NUMBER_PARAMETERS; ++i) {
+			m_fValues[i] = 0;
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeParameters::Set(EParameter e_parameter, Real f_value) {
+		if (!Has(e_parameter)) {
+			m_fValues[e_parameter] = f_value;
+			m_unDefined |= (1 << e_parameter);
+		}
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeParameters::IsEmpty() const {
+		return m_unDefined == 0;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	const char* AutoMoDeParameters::GetName(EParameter e_parameter) {
+		return PARAMETER_NAMES[e_parameter];
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeParameters::FindParameter(const std::string& str_name, EParameter& e_parameter) {
+		for (UInt32 i = 0; i < NUMBER_PARAMETERS; ++i) {
+			if (str_name == PARAMETER_NAMES[i]) {
+				e_parameter = (EParameter) i;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * @file <src/modules/AutoMoDeParameters.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class holds the values of the parameters of a module
+ * 				(behaviour or condition) in a fixed array indexed by the
+ * 				parameter. Names are only used to read configurations and to
+ * 				describe the modules.
+ */
+
+#ifndef AUTOMODE_PARAMETERS_H
+#define AUTOMODE_PARAMETERS_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+
+#include <string>
+
+namespace argos {
+	class AutoMoDeParameters {
+		public:
+			/*
+			 * The parameters the modules can read. New parameters must be appended:
+			 * the values are stored by index in compiled finite state machine files.
+			 * @see AutoMoDeFsmBinary
+			 */
+			enum EParameter {
+				RWM,
+				ATT,
+				REP,
+				VEL,
+				CLE,
+				CLR,
+				P,
+				W,
+				L,
+				NUMBER_PARAMETERS
+			};
+
+			/*
+			 * Class constructor. No parameter has a value.
+			 */
+			AutoMoDeParameters();
+
+			/*
+			 * Gives a value to a parameter, unless it already has one.
+			 */
+			void Set(EParameter e_parameter, Real f_value);
+
+			/*
+			 * Returns whether the parameter has a value.
+			 */
+			bool Has(EParameter e_parameter) const {
+				return (m_unDefined & (1 << e_parameter)) != 0;
+			}
+
+			/*
+			 * Returns the value of the parameter. Only meaningful if Has(e_parameter).
+			 */
+			const Real& Get(EParameter e_parameter) const {
+				return m_fValues[e_parameter];
+			}
+
+			/*
+			 * Returns whether no parameter has a value.
+			 */
+			bool IsEmpty() const;
+
+			/*
+			 * Returns the name of the parameter in the configurations (e.g. rwm).
+			 */
+			static const char* GetName(EParameter e_parameter);
+
+			/*
+			 * Finds the parameter with the given name. Returns false if there is none.
+			 */
+			static bool FindParameter(const std::string& str_name, EParameter& e_parameter);
+
+		private:
+			Real m_fValues[NUMBER_PARAMETERS];
+			UInt32 m_unDefined;
+	};
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * @file <src/modules/AutoMoDeRandomStream.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ */
+
+#include "AutoMoDeRandomStream.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace argos {
+
+	/*
+	 * Multipliers and key increments of Philox4x32.
+	 */
+	static const UInt32 PHILOX_M0 = 0xD2511F53;
+	static const UInt32 PHILOX_M1 = 0xCD9E8D57;
+	static const UInt32 PHILOX_W0 = 0x9E3779B9;
+	static const UInt32 PHILOX_W1 = 0xBB67AE85;
+	static const UInt32 PHILOX_ROUNDS = 10;
+
+	/* 2^-32, mapping 32 random bits to [0,1). */
+	static const Real BITS_TO_UNIT = 1.0 / 4294967296.0;
+
+#ifdef __AVX2__
+	/*
+	 * Returns the high 32 bits of the products of the lanes of m_factor and the
+	 * multiplier m_multiplier (broadcast), m_low being the low 32 bits.
+	 */
+	static inline __m256i MultiplyHighLow(__m256i m_factor, __m256i m_multiplier, __m256i& m_low) {
+		__m256i mEven = _mm256_mul_epu32(m_factor, m_multiplier);
+		__m256i mOdd = _mm256_mul_epu32(_mm256_srli_epi64(m_factor, 32), m_multiplier);
+		m_low = _mm256_mullo_epi32(m_factor, m_multiplier);
+		return _mm256_blend_epi32(_mm256_srli_epi64(mEven, 32), mOdd, 0xAA);
+	}
+#endif
+
+	/*
+	 * Computes the first blocks (counter (0, tick, 0, 0)) of the ticks un_first_tick to
+	 * un_first_tick + POOL_TICKS - 1, one tick per lane.
+	 */
+	static void ComputeFirstBlocks(const UInt32 pun_key[2], UInt32 un_first_tick, UInt32 pun_pool[4][AutoMoDeRandomStream::POOL_TICKS]) {
+#ifdef __AVX2__
+		__m256i mC0 = _mm256_setzero_si256();
+		__m256i mC1 = _mm256_add_epi32(_mm256_set1_epi32(un_first_tick), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		__m256i mC2 = _mm256_setzero_si256();
+		__m256i mC3 = _mm256_setzero_si256();
+		__m256i mM0 = _mm256_set1_epi32(PHILOX_M0);
+		__m256i mM1 = _mm256_set1_epi32(PHILOX_M1);
+		UInt32 unK0 = pun_key[0], unK1 = pun_key[1];
+		for (UInt32 i = 0; i < PHILOX_ROUNDS; ++i) {
+			__m256i mLow0, mLow1;
+			__m256i mHigh0 = MultiplyHighLow(mC0, mM0, mLow0);
+			__m256i mHigh1 = MultiplyHighLow(mC2, mM1, mLow1);
+			mC0 = _mm256_xor_si256(_mm256_xor_si256(mHigh1, mC1), _mm256_set1_epi32(unK0));
+			mC1 = mLow1;
+			mC2 = _mm256_xor_si256(_mm256_xor_si256(mHigh0, mC3), _mm256_set1_epi32(unK1));
+			mC3 = mLow0;
+			unK0 += PHILOX_W0;
+			unK1 += PHILOX_W1;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pun_pool[0]), mC0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pun_pool[1]), mC1);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pun_pool[2]), mC2);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pun_pool[3]), mC3);
+#else
+		UInt32 punCounter[4] = {0, 0, 0, 0};
+		UInt32 punBlock[4];
+		for (UInt32 j = 0; j < AutoMoDeRandomStream::POOL_TICKS; ++j) {
+			punCounter[1] = un_first_tick + j;
+			AutoMoDeRandomStream::Philox(punCounter, pun_key, punBlock);
+			for (UInt32 i = 0; i < 4; ++i) {
+				pun_pool[i][j] = punBlock[i];
+			}
+		}
+#endif
+	}
+
+	/****************************************/
+	/****************************************/
+
+	AutoMoDeRandomStream::AutoMoDeRandomStream() {
+		SetKey(0, 0);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeRandomStream::SetKey(UInt32 un_seed, UInt32 un_robot_id) {
+		m_punKey[0] = un_seed;
+		m_punKey[1] = un_robot_id;
+		m_unPoolFirstTick = 0;
+		m_bPoolValid = false;
+		SetTick(0);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeRandomStream::SetTick(UInt32 un_tick) {
+		m_punCounter[0] = 0;
+		m_punCounter[1] = un_tick;
+		m_punCounter[2] = 0;
+		m_punCounter[3] = 0;
+		m_unUsedWords = 4;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	UInt32 AutoMoDeRandomStream::GetBits() {
+		if (m_unUsedWords == 4) {
+			if (m_punCounter[0] == 0) {
+				UInt32 unTick = m_punCounter[1];
+				if (!m_bPoolValid || unTick - m_unPoolFirstTick >= POOL_TICKS) {
+					RefillPool(unTick);
+				}
+				for (UInt32 i = 0; i < 4; ++i) {
+					m_punBlock[i] = m_punPool[i][unTick - m_unPoolFirstTick];
+				}
+			} else {
+				Philox(m_punCounter, m_punKey, m_punBlock);
+			}
+			m_punCounter[0]++;
+			m_unUsedWords = 0;
+		}
+		return m_punBlock[m_unUsedWords++];
+	}
+
+	/****************************************/
+	/****************************************/
+
+	Real AutoMoDeRandomStream::Uniform() {
+		return GetBits() * BITS_TO_UNIT;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	UInt32 AutoMoDeRandomStream::Uniform(const CRange<UInt32>& c_range) {
+		UInt64 unScaled = static_cast<UInt64>(GetBits()) * (c_range.GetMax() - c_range.GetMin());
+		return c_range.GetMin() + static_cast<UInt32>(unScaled >> 32);
+	}
+
+	/****************************************/
+	/****************************************/
+
+	bool AutoMoDeRandomStream::Bernoulli(Real f_probability) {
+		return Uniform() < f_probability;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeRandomStream::RefillPool(UInt32 un_first_tick) {
+		ComputeFirstBlocks(m_punKey, un_first_tick, m_punPool);
+		m_unPoolFirstTick = un_first_tick;
+		m_bPoolValid = true;
+	}
+
+	/****************************************/
+	/****************************************/
+
+	void AutoMoDeRandomStream::Philox(const UInt32 pun_counter[4], const UInt32 pun_key[2], UInt32 pun_block[4]) {
+		UInt32 unC0 = pun_counter[0], unC1 = pun_counter[1], unC2 = pun_counter[2], unC3 = pun_counter[3];
+		UInt32 unK0 = pun_key[0], unK1 = pun_key[1];
+		for (UInt32 i = 0; i < PHILOX_ROUNDS; ++i) {
+			UInt64 unProduct0 = static_cast<UInt64>(PHILOX_M0) * unC0;
+			UInt64 unProduct1 = static_cast<UInt64>(PHILOX_M1) * unC2;
+			unC0 = static_cast<UInt32>(unProduct1 >> 32) ^ unC1 ^ unK0;
+			unC1 = static_cast<UInt32>(unProduct1);
+			unC2 = static_cast<UInt32>(unProduct0 >> 32) ^ unC3 ^ unK1;
+			unC3 = static_cast<UInt32>(unProduct0);
+			unK0 += PHILOX_W0;
+			unK1 += PHILOX_W1;
+		}
+		pun_block[0] = unC0;
+		pun_block[1] = unC1;
+		pun_block[2] = unC2;
+		pun_block[3] = unC3;
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * @file <src/modules/AutoMoDeRandomStream.h>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief This class gives the random numbers of one robot: the ordering of
+ * 				the transitions, the draws of the conditions and the turns of
+ * 				Exploration. They come from the counter-based generator
+ * 				Philox4x32-10 (Salmon et al., 2011): the n-th block of 128 bits
+ * 				drawn during a tick is a function of (seed, robot, tick, n)
+ * 				only. The decisions of a robot therefore do not depend on the
+ * 				other robots, on the thread stepping it, or on the ticks before,
+ * 				and any tick of any robot can be replayed in isolation.
+ * 				As a robot rarely draws more than one block per tick, the first
+ * 				blocks of POOL_TICKS successive ticks are computed together, with
+ * 				AVX2 when the library is compiled for it (e.g. -mavx2), and kept
+ * 				in a pool. This does not change the numbers drawn.
+ */
+
+#ifndef AUTOMODE_RANDOM_STREAM_H
+#define AUTOMODE_RANDOM_STREAM_H
+
+#include <argos3/core/utility/datatypes/datatypes.h>
+#include <argos3/core/utility/math/range.h>
+
+namespace argos {
+	class AutoMoDeRandomStream {
+		public:
+			/*
+			 * Class constructor. The stream has the key (0, 0) and is at the start of tick 0.
+			 */
+			AutoMoDeRandomStream();
+
+			/*
+			 * Keys the stream with the seed of the experiment and the identifier of the robot,
+			 * and moves it to the start of tick 0.
+			 */
+			void SetKey(UInt32 un_seed, UInt32 un_robot_id);
+
+			/*
+			 * Moves the stream to the start of tick un_tick.
+			 */
+			void SetTick(UInt32 un_tick);
+
+			/*
+			 * Returns the next 32 random bits.
+			 */
+			UInt32 GetBits();
+
+			/*
+			 * Returns a random value drawn uniformly in [0,1).
+			 */
+			Real Uniform();
+
+			/*
+			 * Returns a random value drawn uniformly in [min,max).
+			 */
+			UInt32 Uniform(const CRange<UInt32>& c_range);
+
+			/*
+			 * Returns true with probability f_probability.
+			 */
+			bool Bernoulli(Real f_probability);
+
+			/*
+			 * Computes the block of 128 bits of counter pun_counter and key pun_key.
+			 */
+			static void Philox(const UInt32 pun_counter[4], const UInt32 pun_key[2], UInt32 pun_block[4]);
+
+			/*
+			 * Number of ticks whose first block is computed at once: one per 32-bit lane
+			 * of an AVX2 register.
+			 */
+			static const UInt32 POOL_TICKS = 8;
+
+		private:
+			/*
+			 * Computes the first blocks of the ticks un_first_tick to un_first_tick + POOL_TICKS - 1.
+			 */
+			void RefillPool(UInt32 un_first_tick);
+
+			UInt32 m_punKey[2];
+
+			/*
+			 * Counter of the next block: the index of the block in the tick, then the tick.
+			 */
+			UInt32 m_punCounter[4];
+
+			/*
+			 * The last block computed, and the number of its words already used.
+			 */
+			UInt32 m_punBlock[4];
+			UInt32 m_unUsedWords;
+
+			/*
+			 * Word i of the first block of tick (m_unPoolFirstTick + j) is m_punPool[i][j].
+			 */
+			UInt32 m_punPool[4][POOL_TICKS];
+			UInt32 m_unPoolFirstTick;
+			bool m_bPoolValid;
+	};
+}
+
+#endif
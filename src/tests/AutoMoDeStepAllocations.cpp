@@ -0,0 +1,133 @@
+/*
+ * @file <src/tests/AutoMoDeStepAllocations.cpp>
+ *
+ * @package ARGoS3-AutoMoDe
+ *
+ * @license MIT License
+ *
+ * @brief Checks that stepping a finite state machine does not allocate memory.
+ * 				A swarm of robots is stepped for a number of ticks, with deep
+ * 				copies of the finite state machines of their group, then with
+ * 				instances sharing them. operator new counts the allocations made
+ * 				once the first ticks are over. The test fails if any step allocates.
+ * 				The modules reading containers from the robot state (colors, range
+ * 				and bearing) are left out: the robot state is not part of this
+ * 				library.
+ */
+
+#include <argos3/core/utility/math/rng.h>
+#include <argos3/demiurge/epuck-dao/ReferenceModel3Dot0.h>
+
+#include "../core/AutoMoDeArena.h"
+#include "../core/AutoMoDeFsmTemplates.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace argos;
+
+/*
+ * Number of allocations made while g_bCountAllocations is set.
+ */
+static UInt64 g_unNumberAllocations = 0;
+static bool g_bCountAllocations = false;
+
+void* operator new(size_t un_size) {
+	if (g_bCountAllocations) {
+		++g_unNumberAllocations;
+	}
+	void* pMemory = malloc(un_size > 0 ? un_size : 1);
+	if (pMemory == NULL) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+void operator delete(void* p_memory) noexcept {
+	free(p_memory);
+}
+
+void operator delete(void* p_memory, size_t) noexcept {
+	free(p_memory);
+}
+
+/*
+ * Two groups of three robots, using Exploration, Stop and Phototaxis, and the floor,
+ * neighbors and fixed probability conditions.
+ */
+static const char* FSM_CONFIG =
+	"--ngroups 2 --g0 3 --g1 3 "
+	"--nstates_0 3 --s0_0 0 --rwm0_0 50 --cle0_0 0 --n0_0 2 --n0x0_0 0 --c0x0_0 5 --p0x0_0 0.3 --n0x1_0 1 --c0x1_0 0 --p0x1_0 0.1 "
+	"--s1_0 1 --cle1_0 2 --n1_0 1 --n1x0_0 0 --c1x0_0 5 --p1x0_0 0.5 "
+	"--s2_0 2 --n2_0 2 --n2x0_0 0 --c2x0_0 3 --w2x0_0 2 --p2x0_0 1 --n2x1_0 1 --c2x1_0 5 --p2x1_0 0.05 "
+	"--nstates_1 2 --s0_1 0 --rwm0_1 20 --cle0_1 1 --n0_1 1 --n0x0_1 0 --c0x0_1 5 --p0x0_1 0.2 "
+	"--s1_1 1 --cle1_1 0 --n1_1 1 --n1x0_1 0 --c1x0_1 1 --p1x0_1 0.5";
+
+static const UInt32 NUMBER_ROBOTS = 6;
+static const UInt32 NUMBER_TICKS = 2000;
+
+/*
+ * Ticks during which the allocations are not counted, the first behaviours being entered.
+ */
+static const UInt32 WARM_UP_TICKS = 10;
+
+/*
+ * Steps the swarm, with instances if b_instances, else with deep copies. Returns the
+ * number of allocations per robot and per tick after the warm-up.
+ */
+Real MeasureAllocations(AutoMoDeFsmTemplates& c_templates, bool b_instances) {
+	AutoMoDeArena cArena;
+	std::vector<EpuckDAO*> vecRobotDAO;
+	std::vector<AutoMoDeFiniteStateMachine*> vecFsm;
+	for (UInt32 i = 0; i < NUMBER_ROBOTS; ++i) {
+		EpuckDAO* pcRobotDAO = new ReferenceModel3Dot0();
+		pcRobotDAO->SetRobotIdentifier(i);
+		AutoMoDeFiniteStateMachine* pcFsm = b_instances ? c_templates.CreateFiniteStateMachine(i, cArena) : c_templates.CreateFiniteStateMachine(i);
+		pcFsm->SetRobotDAO(pcRobotDAO);
+		pcFsm->Init();
+		pcFsm->Reset();
+		vecRobotDAO.push_back(pcRobotDAO);
+		vecFsm.push_back(pcFsm);
+	}
+
+	g_unNumberAllocations = 0;
+	for (UInt32 t = 0; t < NUMBER_TICKS; ++t) {
+		g_bCountAllocations = (t >= WARM_UP_TICKS);
+		for (UInt32 i = 0; i < NUMBER_ROBOTS; ++i) {
+			vecFsm[i]->ControlStep();
+		}
+	}
+	g_bCountAllocations = false;
+
+	for (UInt32 i = 0; i < NUMBER_ROBOTS; ++i) {
+		if (b_instances) {
+			vecFsm[i]->~AutoMoDeFiniteStateMachine();
+		} else {
+			delete vecFsm[i];
+		}
+		delete vecRobotDAO[i];
+	}
+	return Real(g_unNumberAllocations) / (NUMBER_ROBOTS * (NUMBER_TICKS - WARM_UP_TICKS));
+}
+
+int main() {
+	try {
+		// The robot states and the random streams of the robots draw from the "argos" category.
+		CRandom::CreateCategory("argos", 1);
+		AutoMoDeFsmTemplates cTemplates((std::string(FSM_CONFIG)));
+
+		Real fDeepCopies = MeasureAllocations(cTemplates, false);
+		Real fInstances = MeasureAllocations(cTemplates, true);
+		std::cout << "Allocations per robot-tick: deep copies " << fDeepCopies << ", instances " << fInstances << std::endl;
+		if (fDeepCopies > 0 || fInstances > 0) {
+			std::cerr << "A step of the finite state machine allocated memory" << std::endl;
+			return 1;
+		}
+	} catch (std::exception& ex) {
+		std::cerr << ex.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
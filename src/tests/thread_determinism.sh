@@ -0,0 +1,74 @@
+#!/bin/bash
+
+# Checks that an evaluation does not depend on the number of threads of ARGoS.
+# The experiment is run at a fixed seed with <system threads="0">, then RUNS times
+# with <system threads="THREADS">, keeping the history of every robot. All the runs
+# must give the same score and the same state histories.
+# The runs are made from temporary directories: the paths in the experiment must
+# be absolute.
+
+# Syntax printing
+function print_syntax() {
+    echo
+    echo "Usage: $0 <AUTOMODE_MAIN> <EXPERIMENT.argos> <SEED> <THREADS> <FSM_CONFIG>..."
+    echo
+    echo "The number of runs with THREADS threads is RUNS (default: 3)."
+    echo
+    exit 1
+}
+
+# Writes the experiment $1 to $3, with $2 threads
+function set_threads() {
+  if grep -q '<system' $1; then
+    sed -E -e 's/(<system[^>]*) threads="[^"]*"/\1/' -e "s/<system/<system threads=\"$2\"/" $1 > $3
+  else
+    sed -E "s/<framework>/<framework>\n    <system threads=\"$2\" \/>/" $1 > $3
+  fi
+}
+
+# Runs the experiment with $1 threads in the directory $2, and prints its score
+function run_experiment() {
+  mkdir -p $2
+  set_threads ${EXPERIMENT} $1 $2/experiment.argos
+  (cd $2 && ${EXE} -n -c experiment.argos --seed ${SEED} --history --fsm-config ${FSM_CONFIG} 2> stderr.txt | grep '^Score ')
+  rm $2/experiment.argos $2/stderr.txt
+}
+
+if [ $# -lt 5 ]; then
+  print_syntax
+fi
+
+EXE=$(readlink -f $1)
+EXPERIMENT=$(readlink -f $2)
+SEED=$3
+THREADS=$4
+shift 4
+FSM_CONFIG="$*"
+RUNS=${RUNS:-3}
+
+WORK_DIR=$(mktemp -d)
+trap "rm -rf ${WORK_DIR}" EXIT
+
+REFERENCE_SCORE=$(run_experiment 0 ${WORK_DIR}/reference)
+if [ -z "${REFERENCE_SCORE}" ]; then
+  echo "The run with threads=\"0\" gave no score"
+  exit 1
+fi
+echo "threads=\"0\": ${REFERENCE_SCORE}"
+
+STATUS=0
+for RUN in $(seq 1 ${RUNS})
+do
+  SCORE=$(run_experiment ${THREADS} ${WORK_DIR}/run_${RUN})
+  echo "threads=\"${THREADS}\" run ${RUN}: ${SCORE}"
+  if [ "${SCORE}" != "${REFERENCE_SCORE}" ]; then
+    echo "The score differs from the run with threads=\"0\""
+    STATUS=1
+  fi
+  if ! diff -r -q ${WORK_DIR}/reference ${WORK_DIR}/run_${RUN}; then
+    echo "The state histories differ from the run with threads=\"0\""
+    STATUS=1
+  fi
+done
+
+exit ${STATUS}